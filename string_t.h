@@ -26,6 +26,32 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <locale.h>
+
+#if !defined(STRING_T_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STRING_T_SSE2
+#include <emmintrin.h>
+#endif
+#if !defined(STRING_T_NO_SIMD) && defined(__SSSE3__)
+#define STRING_T_SSSE3
+#include <tmmintrin.h>
+#endif
+#if !defined(STRING_T_NO_SIMD) && defined(__PCLMUL__)
+#define STRING_T_PCLMUL
+#include <wmmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef STRING_T_POOL
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
 
 /*
  * Custom types
@@ -60,107 +86,613 @@ typedef struct string_t {
 #define STRING_T_SPACE_CHARS_ARR " \t\n\r"
 #endif
 
-const char STRING_T_SPACE_CHARS[] = STRING_T_SPACE_CHARS_ARR;
+#ifndef STRING_T_PARSE_BUFFER_SIZE
+#define STRING_T_PARSE_BUFFER_SIZE 64
+#endif
+
+#ifndef STRING_T_CSV_QUOTE
+#define STRING_T_CSV_QUOTE '"'
+#endif
+
+#ifndef STRING_T_GLOB_WORDS
+#define STRING_T_GLOB_WORDS 4
+#endif
+
+#ifndef STRING_T_FC_BUCKET_SIZE
+#define STRING_T_FC_BUCKET_SIZE 16
+#endif
+
+#ifndef STRING_T_POOL_SLAB_SIZE
+#define STRING_T_POOL_SLAB_SIZE 64
+#endif
+#define STRING_T_POOL_CLASSES 5
+
+#if defined(_MSC_VER)
+#define STRING_T_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define STRING_T_THREAD_LOCAL _Thread_local
+#else
+#define STRING_T_THREAD_LOCAL __thread
+#endif
+
+/* Linkage of lib's functions. Static, so the header can be included by several translation units. */
+#ifndef STRING_T_DEF
+#define STRING_T_DEF static inline
+#endif
+
+/* Numbers parsing statuses. */
+#define STRING_T_PARSE_OK 0
+#define STRING_T_PARSE_INVALID 1
+#define STRING_T_PARSE_OVERFLOW 2
+
+/* Initializer of static string_t by string literal. Its size is computed at compile time. */
+#define STRING_T_INIT(literal) {(char *) ("" literal), sizeof(literal) - 1}
+
+/* Constant string_t pointer by string literal, which needs no allocation and must not be freed. */
+#define STRING_T_LITERAL(literal) (&(const string_t) STRING_T_INIT(literal))
+
+static const char STRING_T_SPACE_CHARS[] = STRING_T_SPACE_CHARS_ARR;
 
 /* Allocate new string by given size. */
-string_t *new_string(size_t);
+STRING_T_DEF string_t *new_string(size_t);
 
 /* Allocate new string by given bytes. */
-string_t *new_string_from_bytes(const char *);
+STRING_T_DEF string_t *new_string_from_bytes(const char *);
 
 /* Free string's allocated memory. */
-void string_free(string_t *);
+STRING_T_DEF void string_free(string_t *);
 
 /* Return string length. */
-size_t string_len(const string_t *);
+STRING_T_DEF size_t string_len(const string_t *);
 
 /* Return string bytes. */
-char *string_bytes(const string_t *);
+STRING_T_DEF char *string_bytes(const string_t *);
 
 /* Return true(0) if strings are equal. */
-bool_t string_eq(const string_t *, const string_t *);
+STRING_T_DEF bool_t string_eq(const string_t *, const string_t *);
+
+/* Return negative, zero or positive number if first string is less, equal or greater than second one. */
+STRING_T_DEF int string_compare(const string_t *, const string_t *);
 
 /* Return copy of the string. */
-string_t *string_copy(const string_t *);
+STRING_T_DEF string_t *string_copy(const string_t *);
 
 /* Return result of 2 strings concatenation. */
-string_t *string_concat(const string_t *, const string_t *);
+STRING_T_DEF string_t *string_concat(const string_t *, const string_t *);
 
 /* Return string's sub string. */
-string_t *string_substr(const string_t *, size_t, size_t);
+STRING_T_DEF string_t *string_substr(const string_t *, size_t, size_t);
 
 /* Return true(0) if string starts with given prefix. */
-bool_t string_startswith(const string_t *, const char[]);
+STRING_T_DEF bool_t string_startswith(const string_t *, const char[]);
 
 /* Return true(0) if string ends with given suffix. */
-bool_t string_endswith(const string_t *, const char[]);
+STRING_T_DEF bool_t string_endswith(const string_t *, const char[]);
 
 /* Returns the index of substring's occurrence in string. Otherwise returns -1. */
-int string_find(const string_t *, const char[]);
+STRING_T_DEF int string_find(const string_t *, const char[]);
+
+/* Return count of non-overlapping substring's occurrences in string. */
+STRING_T_DEF size_t string_count(const string_t *, const char[]);
+
+/*
+ * Write indexes of non-overlapping substring's occurrences into given buffer (at most buffer size)
+ * and return total occurrences count, so buffer can be grown and the call repeated.
+ */
+STRING_T_DEF size_t string_find_all(const string_t *, const char[], size_t *, size_t);
 
 /* Return string without STRING_T_SPACE_CHARS_ARR at the start and end. */
-string_t *string_strip(const string_t *);
+STRING_T_DEF string_t *string_strip(const string_t *);
 
 #ifndef _WIN32
 /* Split string by STRING_T_SPACE_CHARS_ARR symbols and return strings array. */
-STRING_T_ARRAY string_split(const string_t *, size_t *);
+STRING_T_DEF STRING_T_ARRAY string_split(const string_t *, size_t *);
 
 /* Split string by given chars and return strings array. */
-STRING_T_ARRAY string_split_by(const string_t *, size_t *, const char[]);
+STRING_T_DEF STRING_T_ARRAY string_split_by(const string_t *, size_t *, const char[]);
 
 #endif
 /* Join given strings array with separator chars into one string. */
-string_t *string_join_arr(const STRING_T_ARRAY, size_t, const char []);
+STRING_T_DEF string_t *string_join_arr(const STRING_T_ARRAY, size_t, const char []);
+
+/* Strip STRING_T_SPACE_CHARS_ARR at the start and end of every array's string in place. */
+STRING_T_DEF void string_array_strip(STRING_T_ARRAY, size_t);
+
+/* Free array's empty strings, move the rest to the array start and return their count. */
+STRING_T_DEF size_t string_array_filter_empty(STRING_T_ARRAY, size_t);
+
+/* Convert ASCII letters of every array's string to lower case in place. */
+STRING_T_DEF void string_array_map_lower(STRING_T_ARRAY, size_t);
+
+/* Free array's strings and the array itself. */
+STRING_T_DEF void string_array_free(STRING_T_ARRAY, size_t);
+
+/* Parse whole string as signed decimal integer. Return STRING_T_PARSE_* status. */
+STRING_T_DEF int string_parse_i64(const string_t *, int64_t *);
+
+/* Parse whole string as unsigned decimal integer. Return STRING_T_PARSE_* status. */
+STRING_T_DEF int string_parse_u64(const string_t *, uint64_t *);
+
+/* Parse whole string as decimal floating point number. Return STRING_T_PARSE_* status. */
+STRING_T_DEF int string_parse_f64(const string_t *, double *);
+
+/* Parse array's strings as signed integers. Return index of the first failed string or array size. */
+STRING_T_DEF size_t string_parse_i64_arr(STRING_T_ARRAY, size_t, int64_t *);
+
+/* Parse array's strings as unsigned integers. Return index of the first failed string or array size. */
+STRING_T_DEF size_t string_parse_u64_arr(STRING_T_ARRAY, size_t, uint64_t *);
+
+/* Parse array's strings as floating point numbers. Return index of the first failed string or array size. */
+STRING_T_DEF size_t string_parse_f64_arr(STRING_T_ARRAY, size_t, double *);
+
+/* CSV record's field. Value points into parsed bytes and doesn't include enclosing quotes. */
+typedef struct string_csv_field_t {
+    string_t value;
+    bool_t quoted;
+} string_csv_field_t;
+
+/* CSV/TSV reader over bytes buffer, which must outlive the reader and its fields. */
+typedef struct string_csv_t {
+    const char *bytes;
+    size_t size;
+    size_t pos;
+    char delimiter;
+    bool_t is_last_chunk;
+    size_t block_pos;
+    uint64_t structurals;
+    uint64_t in_quotes;
+} string_csv_t;
+
+/*
+ * Init CSV reader over given string with fields delimiter. If string is not the last chunk of input,
+ * unterminated record at its end is not read: reader's pos is the size of consumed bytes.
+ */
+STRING_T_DEF void string_csv_init(string_csv_t *, const string_t *, char, bool_t);
+
+/*
+ * Read next record fields into given buffer (at most buffer size) and set record fields count.
+ * Return false(0) if there are no more complete records.
+ */
+STRING_T_DEF bool_t string_csv_next(string_csv_t *, string_csv_field_t *, size_t, size_t *);
+
+/* Return field value with doubled quotes unescaped. */
+STRING_T_DEF string_t *string_csv_unescape(const string_csv_field_t *);
+
+/* Compiled glob pattern: bit-parallel NFA, where state N means N pattern's chars are matched. */
+typedef struct string_glob_t {
+    uint64_t accept[256][STRING_T_GLOB_WORDS];
+    uint64_t loops[STRING_T_GLOB_WORDS];
+    size_t final_state;
+    size_t words;
+} string_glob_t;
+
+/*
+ * Compile glob pattern with '*', '?', '[abc]', '[a-z]', '[!abc]' and '\\' escapes.
+ * Return NULL if pattern is malformed or has more than STRING_T_GLOB_WORDS * 64 - 1 chars to match.
+ */
+STRING_T_DEF string_glob_t *string_glob_compile(const char[]);
+
+/* Return true(1) if whole string matches compiled glob pattern. */
+STRING_T_DEF bool_t string_glob_match(const string_glob_t *, const string_t *);
+
+/* Free compiled glob pattern. */
+STRING_T_DEF void string_glob_free(string_glob_t *);
+
+/* Return Levenshtein distance between 2 strings. */
+STRING_T_DEF size_t string_levenshtein(const string_t *, const string_t *);
+
+/* Return true(1) if Levenshtein distance between 2 strings is not greater than given one. */
+STRING_T_DEF bool_t string_levenshtein_within(const string_t *, const string_t *, size_t);
+
+/*
+ * Returns the index of substring's approximate occurrence in string with at most given
+ * Levenshtein distance. Otherwise returns -1.
+ */
+STRING_T_DEF int string_fuzzy_find(const string_t *, const char[], size_t);
+
+/* Return base64 encoded size of given bytes count. */
+STRING_T_DEF size_t string_base64_encoded_len(size_t);
+
+/* Encode string as base64 into buffer of string_base64_encoded_len size. Return written size. */
+STRING_T_DEF size_t string_base64_encode_to(const string_t *, char *);
+
+/* Return base64 encoded string. */
+STRING_T_DEF string_t *string_base64_encode(const string_t *);
+
+/* Return decoded size of base64 string. */
+STRING_T_DEF size_t string_base64_decoded_len(const string_t *);
+
+/*
+ * Decode base64 string into buffer of string_base64_decoded_len size and set written size.
+ * Return false(0) if string is not valid padded base64.
+ */
+STRING_T_DEF bool_t string_base64_decode_to(const string_t *, char *, size_t *);
+
+/* Return base64 decoded string or NULL if string is not valid padded base64. */
+STRING_T_DEF string_t *string_base64_decode(const string_t *);
+
+/* Encode string as lower case hex into buffer of doubled string size. Return written size. */
+STRING_T_DEF size_t string_hex_encode_to(const string_t *, char *);
+
+/* Return hex encoded string. */
+STRING_T_DEF string_t *string_hex_encode(const string_t *);
+
+/*
+ * Decode hex string into buffer of halved string size and set written size.
+ * Return false(0) if string is not valid hex.
+ */
+STRING_T_DEF bool_t string_hex_decode_to(const string_t *, char *, size_t *);
+
+/* Return hex decoded string or NULL if string is not valid hex. */
+STRING_T_DEF string_t *string_hex_decode(const string_t *);
+
+/* Compressed radix trie node. Node's children are stored contiguously. */
+typedef struct string_t_trie_node_t {
+    size_t label_pos;
+    size_t label_len;
+    size_t first_child;
+    size_t children_count;
+    bool_t is_terminal;
+} string_t_trie_node_t;
+
+/* Compiled set of prefixes (or suffixes). Suffixes are stored reversed. */
+typedef struct string_prefix_set_t {
+    string_t_trie_node_t *nodes;
+    unsigned char *child_keys;
+    char *bytes;
+    size_t nodes_count;
+    bool_t is_suffix;
+} string_prefix_set_t;
+
+/* Compile set of given prefixes. */
+STRING_T_DEF string_prefix_set_t *new_string_prefix_set(const char *[], size_t);
+
+/* Compile set of given suffixes. */
+STRING_T_DEF string_prefix_set_t *new_string_suffix_set(const char *[], size_t);
+
+/* Return length of the longest set's prefix (or suffix) of string. Otherwise returns -1. */
+STRING_T_DEF int string_prefix_set_longest_match(const string_prefix_set_t *, const string_t *);
+
+/* Return true(1) if string starts (or ends) with any set's prefix (or suffix). */
+STRING_T_DEF bool_t string_prefix_set_any_match(const string_prefix_set_t *, const string_t *);
+
+/* Free compiled prefix set. */
+STRING_T_DEF void string_prefix_set_free(string_prefix_set_t *);
+
+/* Sort array's strings in place by string_compare order. */
+STRING_T_DEF void string_array_sort(STRING_T_ARRAY, size_t);
+
+/* Sort array's strings in place, free duplicates and return unique strings count. */
+STRING_T_DEF size_t string_array_sort_unique(STRING_T_ARRAY, size_t);
+
+/*
+ * Immutable front coded array of sorted strings. Strings are split into buckets: bucket's first
+ * string is stored as varint length and bytes, the next ones as varint length of prefix shared
+ * with the previous string, varint length of the rest and the rest bytes.
+ */
+typedef struct string_fc_array_t {
+    unsigned char *bytes;
+    size_t *bucket_offsets;
+    size_t size;
+    size_t bucket_size;
+    size_t max_len;
+} string_fc_array_t;
+
+/* Sequential iterator over front coded array. Current string is decoded into caller's buffer. */
+typedef struct string_fc_iter_t {
+    const string_fc_array_t *arr;
+    size_t idx;
+    size_t pos;
+    string_t str;
+} string_fc_iter_t;
+
+/*
+ * Build front coded array of sorted strings with given bucket size (0 for STRING_T_FC_BUCKET_SIZE).
+ * Return NULL if strings are not sorted.
+ */
+STRING_T_DEF string_fc_array_t *new_string_fc_array(STRING_T_ARRAY, size_t, size_t);
+
+/* Return front coded array's strings count. */
+STRING_T_DEF size_t string_fc_array_len(const string_fc_array_t *);
+
+/* Decode string by index into buffer of at least max_len + 1 bytes. Return string length. */
+STRING_T_DEF size_t string_fc_array_get(const string_fc_array_t *, size_t, char *);
+
+/* Return string by index. */
+STRING_T_DEF string_t *string_fc_array_at(const string_fc_array_t *, size_t);
+
+/* Return count of array's strings less than given one. */
+STRING_T_DEF size_t string_fc_array_rank(const string_fc_array_t *, const string_t *);
+
+/* Returns the index of string in front coded array. Otherwise returns -1. */
+STRING_T_DEF int string_fc_array_find(const string_fc_array_t *, const string_t *);
+
+/* Init iterator over front coded array, which decodes strings into buffer of at least max_len + 1 bytes. */
+STRING_T_DEF void string_fc_iter_init(string_fc_iter_t *, const string_fc_array_t *, char *);
+
+/* Decode next string into iterator's str. Return false(0) if there are no more strings. */
+STRING_T_DEF bool_t string_fc_iter_next(string_fc_iter_t *);
+
+/* Free front coded array. */
+STRING_T_DEF void string_fc_array_free(string_fc_array_t *);
+
+#ifdef STRING_T_POOL
+/*
+ * Thread's pool of blocks by size classes of 16, 32, 64, 128 and 256 bytes. Blocks freed by
+ * other threads are pushed to the lock-free returned stack and are taken back by the owner.
+ * Slabs may hold strings of other threads, so pool of exited thread is pushed to the orphan
+ * pools stack and is adopted by the next thread, which needs a pool.
+ */
+typedef struct string_t_pool_t {
+    void *free_lists[STRING_T_POOL_CLASSES];
+    void *returned;
+    struct string_t_pool_t *next_orphan;
+} string_t_pool_t;
+
+/* Pooled block header, block's payload follows it. Free block's payload holds the next block. */
+typedef struct string_t_pool_block_t {
+    string_t_pool_t *owner;
+    size_t size_class;
+} string_t_pool_block_t;
+
+static STRING_T_THREAD_LOCAL string_t_pool_t *string_t_local_pool = NULL;
+static void *string_t_orphan_pools = NULL;
+
+/* Atomically load pointer. */
+STRING_T_DEF void *string_t_atomic_load(void **target) {
+#ifdef _MSC_VER
+    return *(void *volatile *) target;
+#else
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+/* Atomically replace pointer with given one and return the previous pointer. */
+STRING_T_DEF void *string_t_atomic_exchange(void **target, void *value) {
+#ifdef _MSC_VER
+    return _InterlockedExchangePointer(target, value);
+#else
+    return __atomic_exchange_n(target, value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/* Replace expected value with given one if target wasn't changed. Return true(1) on success. */
+STRING_T_DEF bool_t string_t_atomic_cas(void **target, void *expected, void *value) {
+#ifdef _MSC_VER
+    return _InterlockedCompareExchangePointer(target, value, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(target, &expected, value, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+#endif
+}
+
+/* Push block's payload onto free list. */
+STRING_T_DEF void string_t_pool_push(void **list, void *payload) {
+    memcpy(payload, list, sizeof(void *));
+    *list = payload;
+}
+
+/* Allocate new slab of blocks of given size class into the pool's free list. */
+STRING_T_DEF void string_t_pool_refill(string_t_pool_t *pool, size_t size_class) {
+    size_t block_size = sizeof(string_t_pool_block_t) + ((size_t) 16 << size_class);
+    char *slab = malloc(block_size * STRING_T_POOL_SLAB_SIZE);
+    for (size_t idx = 0; idx < STRING_T_POOL_SLAB_SIZE; ++idx) {
+        string_t_pool_block_t *block = (string_t_pool_block_t *) (slab + idx * block_size);
+        block->owner = pool;
+        block->size_class = size_class;
+        string_t_pool_push(pool->free_lists + size_class, block + 1);
+    }
+}
+
+/* Move blocks freed by other threads to the pool's free lists. */
+STRING_T_DEF void string_t_pool_drain(string_t_pool_t *pool) {
+    void *payload = string_t_atomic_exchange(&pool->returned, NULL);
+    while (payload != NULL) {
+        void *next;
+        memcpy(&next, payload, sizeof(void *));
+        string_t_pool_block_t *block = (string_t_pool_block_t *) payload - 1;
+        string_t_pool_push(pool->free_lists + block->size_class, payload);
+        payload = next;
+    }
+}
+
+/* Push pool of exiting thread to the orphan pools stack. */
+STRING_T_DEF void string_t_pool_orphan(string_t_pool_t *pool) {
+    void *orphans;
+    do {
+        orphans = string_t_atomic_load(&string_t_orphan_pools);
+        pool->next_orphan = orphans;
+    } while (!string_t_atomic_cas(&string_t_orphan_pools, orphans, pool));
+}
+
+/*
+ * Pop orphan pool or return NULL. The whole stack is taken at once, so concurrent pops can't
+ * see a reused pool (ABA), and the rest pools are pushed back.
+ */
+STRING_T_DEF string_t_pool_t *string_t_pool_adopt(void) {
+    string_t_pool_t *pool = string_t_atomic_exchange(&string_t_orphan_pools, NULL);
+    if (pool == NULL || pool->next_orphan == NULL) {
+        return pool;
+    }
+    string_t_pool_t *rest = pool->next_orphan;
+    string_t_pool_t *last = rest;
+    for (; last->next_orphan != NULL; last = last->next_orphan);
+    void *orphans;
+    do {
+        orphans = string_t_atomic_load(&string_t_orphan_pools);
+        last->next_orphan = orphans;
+    } while (!string_t_atomic_cas(&string_t_orphan_pools, orphans, rest));
+    pool->next_orphan = NULL;
+    return pool;
+}
+
+#ifdef _WIN32
+static DWORD string_t_pool_fls_index = FLS_OUT_OF_INDEXES;
+static INIT_ONCE string_t_pool_fls_once = INIT_ONCE_STATIC_INIT;
+
+/* Thread exit callback, which orphans thread's pool. */
+STRING_T_DEF VOID WINAPI string_t_pool_on_exit(PVOID pool) {
+    if (pool != NULL) {
+        string_t_local_pool = NULL;
+        string_t_pool_orphan(pool);
+    }
+}
+
+/* Allocate fiber local slot with thread exit callback. */
+STRING_T_DEF BOOL CALLBACK string_t_pool_init_exit(PINIT_ONCE once, PVOID param, PVOID *context) {
+    (void) once;
+    (void) param;
+    (void) context;
+    string_t_pool_fls_index = FlsAlloc(&string_t_pool_on_exit);
+    return TRUE;
+}
+
+/* Orphan pool when current thread exits. */
+STRING_T_DEF void string_t_pool_register_exit(string_t_pool_t *pool) {
+    InitOnceExecuteOnce(&string_t_pool_fls_once, &string_t_pool_init_exit, NULL, NULL);
+    FlsSetValue(string_t_pool_fls_index, pool);
+}
+#else
+static pthread_key_t string_t_pool_key;
+static pthread_once_t string_t_pool_key_once = PTHREAD_ONCE_INIT;
+
+/* Thread exit destructor, which orphans thread's pool. */
+STRING_T_DEF void string_t_pool_on_exit(void *pool) {
+    string_t_local_pool = NULL;
+    string_t_pool_orphan(pool);
+}
+
+/* Create thread specific key with thread exit destructor. */
+STRING_T_DEF void string_t_pool_init_exit(void) {
+    pthread_key_create(&string_t_pool_key, &string_t_pool_on_exit);
+}
+
+/* Orphan pool when current thread exits. */
+STRING_T_DEF void string_t_pool_register_exit(string_t_pool_t *pool) {
+    pthread_once(&string_t_pool_key_once, &string_t_pool_init_exit);
+    pthread_setspecific(string_t_pool_key, pool);
+}
+#endif
+
+/* Allocate memory from current thread's pool. */
+STRING_T_DEF void *string_t_mem_alloc(size_t size) {
+    size_t size_class = 0;
+    for (; size_class < STRING_T_POOL_CLASSES && ((size_t) 16 << size_class) < size; ++size_class);
+    if (size_class == STRING_T_POOL_CLASSES) {
+        string_t_pool_block_t *block = malloc(sizeof(string_t_pool_block_t) + size);
+        block->owner = NULL;
+        block->size_class = size_class;
+        return block + 1;
+    }
+
+    string_t_pool_t *pool = string_t_local_pool;
+    if (pool == NULL) {
+        pool = string_t_pool_adopt();
+        pool = pool != NULL ? pool : calloc(1, sizeof(string_t_pool_t));
+        string_t_local_pool = pool;
+        string_t_pool_register_exit(pool);
+    }
+    if (pool->free_lists[size_class] == NULL) {
+        string_t_pool_drain(pool);
+    }
+    if (pool->free_lists[size_class] == NULL) {
+        string_t_pool_refill(pool, size_class);
+    }
+    void *payload = pool->free_lists[size_class];
+    memcpy(pool->free_lists + size_class, payload, sizeof(void *));
+    return payload;
+}
+
+/* Return memory to its owner's pool. */
+STRING_T_DEF void string_t_mem_free(void *payload) {
+    if (payload == NULL) {
+        return;
+    }
+    string_t_pool_block_t *block = (string_t_pool_block_t *) payload - 1;
+    string_t_pool_t *owner = block->owner;
+    if (owner == NULL) {
+        free(block);
+    } else if (owner == string_t_local_pool) {
+        string_t_pool_push(owner->free_lists + block->size_class, payload);
+    } else {
+        void *returned;
+        do {
+            returned = string_t_atomic_load(&owner->returned);
+            memcpy(payload, &returned, sizeof(void *));
+        } while (!string_t_atomic_cas(&owner->returned, returned, payload));
+    }
+}
+#else
+/* Allocate memory for strings. */
+STRING_T_DEF void *string_t_mem_alloc(size_t size) {
+    return malloc(size);
+}
+
+/* Free memory of strings. */
+STRING_T_DEF void string_t_mem_free(void *ptr) {
+    free(ptr);
+}
+#endif
 
-string_t *new_string(size_t size) {
-    string_t *str = malloc(sizeof(string_t));
+STRING_T_DEF string_t *new_string(size_t size) {
+    string_t *str = string_t_mem_alloc(sizeof(string_t));
     str->size = size;
-    str->bytes = calloc(size, sizeof(char));
+    str->bytes = string_t_mem_alloc(size + 1);
+    memset(str->bytes, 0, size + 1);
     return str;
 }
 
-string_t *new_string_from_bytes(const char *bytes) {
+STRING_T_DEF string_t *new_string_from_bytes(const char *bytes) {
     string_t *str = new_string(strlen(bytes));
     strcpy(str->bytes, bytes);
     return str;
 }
 
-void string_free(string_t *str) {
-    free(str->bytes);
-    free(str);
+STRING_T_DEF void string_free(string_t *str) {
+    string_t_mem_free(str->bytes);
+    string_t_mem_free(str);
 }
 
-size_t string_len(const string_t *str) {
+STRING_T_DEF size_t string_len(const string_t *str) {
     return str->size;
 }
 
-char *string_bytes(const string_t *str) {
-    char *buf = calloc(sizeof(char), str->size);
-    strcpy(buf, str->bytes);
+STRING_T_DEF char *string_bytes(const string_t *str) {
+    char *buf = calloc(sizeof(char), str->size + 1);
+    memcpy(buf, str->bytes, str->size);
     return buf;
 }
 
-bool_t string_eq(const string_t *left, const string_t *right) {
-    if (left->size != right->size || strcmp(left->bytes, right->bytes) != 0) {
+STRING_T_DEF bool_t string_eq(const string_t *left, const string_t *right) {
+    if (left->size != right->size || memcmp(left->bytes, right->bytes, left->size) != 0) {
         return false;
     }
     return true;
 }
 
-string_t *string_copy(const string_t *str) {
+STRING_T_DEF int string_compare(const string_t *left, const string_t *right) {
+    size_t len = left->size < right->size ? left->size : right->size;
+    int res = memcmp(left->bytes, right->bytes, len);
+    if (res != 0) {
+        return res;
+    }
+    return (left->size > right->size) - (left->size < right->size);
+}
+
+STRING_T_DEF string_t *string_copy(const string_t *str) {
     string_t *copied_str = new_string(str->size);
-    strcpy(copied_str->bytes, str->bytes);
+    memcpy(copied_str->bytes, str->bytes, str->size);
     return copied_str;
 }
 
-string_t *string_concat(const string_t *first, const string_t *second) {
+STRING_T_DEF string_t *string_concat(const string_t *first, const string_t *second) {
     string_t *new_str = new_string(first->size + second->size);
-    strcpy(new_str->bytes, strcat(first->bytes, second->bytes));
+    memcpy(new_str->bytes, first->bytes, first->size);
+    memcpy(new_str->bytes + first->size, second->bytes, second->size);
     return new_str;
 }
 
-int string_t_is_space_char(char byte) {
-    for (size_t idx = 0; idx < strlen(STRING_T_SPACE_CHARS); ++idx) {
+STRING_T_DEF int string_t_is_space_char(char byte) {
+    for (size_t idx = 0; idx < sizeof(STRING_T_SPACE_CHARS) - 1; ++idx) {
         if (STRING_T_SPACE_CHARS[idx] == byte) {
             return 1;
         }
@@ -168,7 +700,56 @@ int string_t_is_space_char(char byte) {
     return 0;
 }
 
-string_t *string_substr(const string_t *str, size_t pos, size_t len) {
+/* Return index of the lowest set bit. Mask must not be 0. */
+STRING_T_DEF int string_t_ctz64(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return (int) idx;
+#else
+    int idx = 0;
+    for (; (mask & 1) == 0; mask >>= 1, ++idx);
+    return idx;
+#endif
+}
+
+/* Return count of set bits. */
+STRING_T_DEF int string_t_popcount64(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(mask);
+#else
+    mask = mask - ((mask >> 1) & 0x5555555555555555ULL);
+    mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int) ((mask * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/* Return bitmask of the block (up to 64 bytes) positions where byte occurs. */
+STRING_T_DEF uint64_t string_t_eq_mask64(const char *block, size_t len, char byte) {
+    uint64_t mask = 0;
+#ifdef STRING_T_SSE2
+    if (len == 64) {
+        const __m128i needle = _mm_set1_epi8(byte);
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *) (block + lane * 16));
+            uint64_t bits = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+            mask |= bits << (lane * 16);
+        }
+        return mask;
+    }
+#endif
+    for (size_t idx = 0; idx < len; ++idx) {
+        if (block[idx] == byte) {
+            mask |= (uint64_t) 1 << idx;
+        }
+    }
+    return mask;
+}
+
+STRING_T_DEF string_t *string_substr(const string_t *str, size_t pos, size_t len) {
     string_t *sub_str = new_string(len);
     for (size_t idx = 0; idx < len; idx++) {
         sub_str->bytes[idx] = str->bytes[pos + idx];
@@ -177,55 +758,86 @@ string_t *string_substr(const string_t *str, size_t pos, size_t len) {
     return sub_str;
 }
 
-bool_t string_startswith(const string_t *str, const char suffix[]) {
-    if (str->size < strlen(suffix)) {
-        return false;
-    }
-    string_t *exp_suffix = new_string_from_bytes(suffix);
-    string_t *str_suffix = string_substr(str, 0, exp_suffix->size);
-
-    bool_t is_suffix = string_eq(str_suffix, exp_suffix);
-    string_free(str_suffix);
-    string_free(exp_suffix);
+STRING_T_DEF bool_t string_startswith(const string_t *str, const char prefix[]) {
+    size_t prefix_len = strlen(prefix);
+    return str->size >= prefix_len && memcmp(str->bytes, prefix, prefix_len) == 0;
+}
 
-    return is_suffix;
+STRING_T_DEF bool_t string_endswith(const string_t *str, const char suffix[]) {
+    size_t suffix_len = strlen(suffix);
+    return str->size >= suffix_len && memcmp(str->bytes + str->size - suffix_len, suffix, suffix_len) == 0;
 }
 
-bool_t string_endswith(const string_t *str, const char prefix[]) {
-    if (str->size < strlen(prefix)) {
-        return false;
+STRING_T_DEF int string_find(const string_t *str, const char chars[]) {
+    size_t chars_len = strlen(chars);
+    if (chars_len == 0) {
+        return 0;
     }
-    string_t *exp_prefix = new_string_from_bytes(prefix);
-    string_t *str_prefix = string_substr(str, str->size - exp_prefix->size, exp_prefix->size);
-
-    bool_t is_suffix = string_eq(str_prefix, exp_prefix);
-    string_free(str_prefix);
-    string_free(exp_prefix);
+    const char *end = str->bytes + str->size;
+    for (const char *pos = str->bytes; (size_t) (end - pos) >= chars_len; ++pos) {
+        pos = memchr(pos, chars[0], (size_t) (end - pos) - chars_len + 1);
+        if (pos == NULL) {
+            break;
+        }
+        if (memcmp(pos + 1, chars + 1, chars_len - 1) == 0) {
+            return (int) (pos - str->bytes);
+        }
+    }
+    return -1;
+}
 
-    return is_suffix;
+STRING_T_DEF size_t string_count(const string_t *str, const char chars[]) {
+    if (strlen(chars) != 1) {
+        return string_find_all(str, chars, NULL, 0);
+    }
+    size_t count = 0;
+    for (size_t block = 0; block < str->size; block += 64) {
+        size_t block_len = str->size - block < 64 ? str->size - block : 64;
+        count += string_t_popcount64(string_t_eq_mask64(str->bytes + block, block_len, chars[0]));
+    }
+    return count;
 }
 
-int string_find(const string_t *str, const char chars[]) {
-    string_t *chars_str = new_string_from_bytes(chars);
-    if (chars_str->size == 0) {
-        string_free(chars_str);
+STRING_T_DEF size_t string_find_all(const string_t *str, const char chars[], size_t *offsets, size_t offsets_size) {
+    size_t chars_len = strlen(chars);
+    size_t count = 0;
+    if (chars_len == 0) {
+        for (size_t pos = 0; pos <= str->size; ++pos, ++count) {
+            if (count < offsets_size) {
+                offsets[count] = pos;
+            }
+        }
+        return count;
+    }
+    if (chars_len > str->size) {
         return 0;
     }
-    for (size_t pos = 0; pos < str->size; ++pos) {
-        string_t *sub_str = string_substr(str, pos, chars_str->size);
-        if (string_eq(sub_str, chars_str) == true) {
-            string_free(chars_str);
-            string_free(sub_str);
-            return (int) pos;
+
+    size_t last_pos = str->size - chars_len;
+    size_t next_pos = 0;
+    for (size_t block = 0; block <= last_pos; block += 64) {
+        size_t block_len = str->size - block < 64 ? str->size - block : 64;
+        uint64_t mask = string_t_eq_mask64(str->bytes + block, block_len, chars[0]);
+        while (mask != 0) {
+            size_t pos = block + string_t_ctz64(mask);
+            mask &= mask - 1;
+            if (pos > last_pos) {
+                break;
+            }
+            if (pos < next_pos || memcmp(str->bytes + pos + 1, chars + 1, chars_len - 1) != 0) {
+                continue;
+            }
+            if (count < offsets_size) {
+                offsets[count] = pos;
+            }
+            ++count;
+            next_pos = pos + chars_len;
         }
-        string_free(sub_str);
     }
-    string_free(chars_str);
-
-    return -1;
+    return count;
 }
 
-string_t *string_strip(const string_t *str) {
+STRING_T_DEF string_t *string_strip(const string_t *str) {
     size_t start_pos = 0;
     for (; start_pos < str->size && string_t_is_space_char(str->bytes[start_pos]); ++start_pos);
     int end_pos = (int) str->size - 1;
@@ -239,7 +851,7 @@ string_t *string_strip(const string_t *str) {
 
 #ifndef _WIN32
 
-STRING_T_ARRAY string_split(const string_t *str, size_t *arr_size) {
+STRING_T_DEF STRING_T_ARRAY string_split(const string_t *str, size_t *arr_size) {
     size_t str_count = 0;
     size_t indexes[STRING_T_INDEXES_BUFFER_SIZE];
 
@@ -289,7 +901,7 @@ STRING_T_ARRAY string_split(const string_t *str, size_t *arr_size) {
     return str_arr;
 }
 
-STRING_T_ARRAY string_split_by(const string_t *str, size_t *arr_size, const char split_chars[]) {
+STRING_T_DEF STRING_T_ARRAY string_split_by(const string_t *str, size_t *arr_size, const char split_chars[]) {
     size_t str_count = 0;
     size_t indexes[STRING_T_INDEXES_BUFFER_SIZE];
 
@@ -344,7 +956,7 @@ STRING_T_ARRAY string_split_by(const string_t *str, size_t *arr_size, const char
 }
 #endif
 
-string_t *string_join_arr(const STRING_T_ARRAY str_arr, size_t arr_size, const char space_chars[]) {
+STRING_T_DEF string_t *string_join_arr(const STRING_T_ARRAY str_arr, size_t arr_size, const char space_chars[]) {
     size_t str_size = strlen(space_chars) * (arr_size - 1);  // for space chars
     for (size_t idx = 0; idx < arr_size; ++idx) {
         str_size += str_arr[idx]->size;
@@ -353,7 +965,7 @@ string_t *string_join_arr(const STRING_T_ARRAY str_arr, size_t arr_size, const c
     string_t *join_str = new_string(str_size);
     size_t offset = 0;
     for (size_t idx = 0; idx < arr_size; ++idx) {
-        strcpy(join_str->bytes + offset, str_arr[idx]->bytes);
+        memcpy(join_str->bytes + offset, str_arr[idx]->bytes, str_arr[idx]->size);
         offset += str_arr[idx]->size;
         if (idx != arr_size - 1) {
             strcpy(join_str->bytes + offset, space_chars);
@@ -363,4 +975,1445 @@ string_t *string_join_arr(const STRING_T_ARRAY str_arr, size_t arr_size, const c
 
     return join_str;
 }
+
+STRING_T_DEF void string_array_strip(STRING_T_ARRAY str_arr, size_t arr_size) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        string_t *str = str_arr[idx];
+        size_t start_pos = 0;
+        for (; start_pos < str->size && string_t_is_space_char(str->bytes[start_pos]); ++start_pos);
+        size_t end_pos = str->size;
+        for (; end_pos > start_pos && string_t_is_space_char(str->bytes[end_pos - 1]); --end_pos);
+
+        if (end_pos - start_pos == str->size) {
+            continue;
+        }
+        memmove(str->bytes, str->bytes + start_pos, end_pos - start_pos);
+        str->size = end_pos - start_pos;
+        str->bytes[str->size] = '\0';
+    }
+}
+
+STRING_T_DEF size_t string_array_filter_empty(STRING_T_ARRAY str_arr, size_t arr_size) {
+    size_t filtered_size = 0;
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        if (str_arr[idx]->size == 0) {
+            string_free(str_arr[idx]);
+        } else {
+            str_arr[filtered_size++] = str_arr[idx];
+        }
+    }
+    return filtered_size;
+}
+
+/* Convert upper case ASCII letters of 8 packed bytes to lower case. */
+STRING_T_DEF uint64_t string_t_lower64(uint64_t word) {
+    const uint64_t high_bits = 0x8080808080808080ULL;
+    uint64_t heptets = word & ~high_bits;
+    uint64_t is_gt_z = heptets + 0x2525252525252525ULL;
+    uint64_t is_ge_a = heptets + 0x3F3F3F3F3F3F3F3FULL;
+    uint64_t is_upper = ~word & (is_ge_a ^ is_gt_z) & high_bits;
+    return word | (is_upper >> 2);
+}
+
+STRING_T_DEF void string_array_map_lower(STRING_T_ARRAY str_arr, size_t arr_size) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        string_t *str = str_arr[idx];
+        size_t pos = 0;
+        for (; pos + 8 <= str->size; pos += 8) {
+            uint64_t word;
+            memcpy(&word, str->bytes + pos, 8);
+            word = string_t_lower64(word);
+            memcpy(str->bytes + pos, &word, 8);
+        }
+        for (; pos < str->size; ++pos) {
+            if (str->bytes[pos] >= 'A' && str->bytes[pos] <= 'Z') {
+                str->bytes[pos] += 'a' - 'A';
+            }
+        }
+    }
+}
+
+STRING_T_DEF void string_array_free(STRING_T_ARRAY str_arr, size_t arr_size) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        string_free(str_arr[idx]);
+    }
+    free(str_arr);
+}
+
+/* Load 8 bytes as little endian word. */
+STRING_T_DEF uint64_t string_t_load64(const char *bytes) {
+    uint64_t word;
+    memcpy(&word, bytes, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/* Return true(1) if all 8 packed bytes are ASCII digits. */
+STRING_T_DEF bool_t string_t_is_8digits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/* Convert 8 packed ASCII digits into number. */
+STRING_T_DEF uint64_t string_t_parse_8digits(uint64_t word) {
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+            (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+    return word;
+}
+
+/* Parse non-empty digits sequence as unsigned integer. */
+STRING_T_DEF int string_t_parse_digits(const char *bytes, size_t len, uint64_t *value) {
+    if (len == 0) {
+        return STRING_T_PARSE_INVALID;
+    }
+    size_t pos = 0;
+    for (; pos + 1 < len && bytes[pos] == '0'; ++pos);
+
+    // Up to 19 digits always fit into uint64_t
+    size_t safe_len = len - pos > 19 ? pos + 19 : len;
+    uint64_t result = 0;
+    for (; pos + 8 <= safe_len; pos += 8) {
+        uint64_t word = string_t_load64(bytes + pos);
+        if (!string_t_is_8digits(word)) {
+            return STRING_T_PARSE_INVALID;
+        }
+        result = result * 100000000 + string_t_parse_8digits(word);
+    }
+    for (; pos < safe_len; ++pos) {
+        unsigned digit = (unsigned char) bytes[pos] - '0';
+        if (digit > 9) {
+            return STRING_T_PARSE_INVALID;
+        }
+        result = result * 10 + digit;
+    }
+    if (pos < len) {
+        for (size_t idx = pos; idx < len; ++idx) {
+            if ((unsigned) ((unsigned char) bytes[idx] - '0') > 9) {
+                return STRING_T_PARSE_INVALID;
+            }
+        }
+        unsigned digit = (unsigned char) bytes[pos] - '0';
+        if (len - pos > 1 || result > (UINT64_MAX - digit) / 10) {
+            return STRING_T_PARSE_OVERFLOW;
+        }
+        result = result * 10 + digit;
+    }
+    *value = result;
+    return STRING_T_PARSE_OK;
+}
+
+STRING_T_DEF int string_parse_u64(const string_t *str, uint64_t *value) {
+    size_t pos = str->size > 0 && str->bytes[0] == '+' ? 1 : 0;
+    return string_t_parse_digits(str->bytes + pos, str->size - pos, value);
+}
+
+STRING_T_DEF int string_parse_i64(const string_t *str, int64_t *value) {
+    bool_t negative = str->size > 0 && str->bytes[0] == '-';
+    size_t pos = str->size > 0 && (str->bytes[0] == '-' || str->bytes[0] == '+') ? 1 : 0;
+
+    uint64_t abs_value;
+    int status = string_t_parse_digits(str->bytes + pos, str->size - pos, &abs_value);
+    if (status != STRING_T_PARSE_OK) {
+        return status;
+    }
+    if (abs_value > (uint64_t) INT64_MAX + negative) {
+        return STRING_T_PARSE_OVERFLOW;
+    }
+    *value = negative ? (int64_t) (0 - abs_value) : (int64_t) abs_value;
+    return STRING_T_PARSE_OK;
+}
+
+/*
+ * Parse decimal number with strtod, used when fast path is not exact.
+ * The '.' is replaced by locale's decimal point, since strtod follows LC_NUMERIC.
+ */
+STRING_T_DEF int string_t_parse_f64_slow(const string_t *str, double *value) {
+    const char *decimal_point = localeconv()->decimal_point;
+    size_t decimal_point_len = strlen(decimal_point);
+    size_t bytes_size = str->size + decimal_point_len;
+    char buffer[STRING_T_PARSE_BUFFER_SIZE];
+    char *bytes = bytes_size < sizeof(buffer) ? buffer : malloc(bytes_size + 1);
+    size_t len = 0;
+    for (size_t pos = 0; pos < str->size; ++pos) {
+        if (str->bytes[pos] == '.') {
+            memcpy(bytes + len, decimal_point, decimal_point_len);
+            len += decimal_point_len;
+        } else {
+            bytes[len++] = str->bytes[pos];
+        }
+    }
+    bytes[len] = '\0';
+
+    errno = 0;
+    char *end;
+    double result = strtod(bytes, &end);
+    bool_t parsed = end == bytes + len;
+    bool_t overflow = errno == ERANGE && (result > 1 || result < -1);
+    if (bytes != buffer) {
+        free(bytes);
+    }
+    if (!parsed) {
+        return STRING_T_PARSE_INVALID;
+    }
+    if (overflow) {
+        return STRING_T_PARSE_OVERFLOW;
+    }
+    *value = result;
+    return STRING_T_PARSE_OK;
+}
+
+STRING_T_DEF int string_parse_f64(const string_t *str, double *value) {
+    static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *bytes = str->bytes;
+    size_t pos = 0;
+    bool_t negative = str->size > 0 && bytes[0] == '-';
+    if (str->size > 0 && (bytes[0] == '-' || bytes[0] == '+')) {
+        ++pos;
+    }
+
+    uint64_t mantissa = 0;
+    size_t mantissa_digits = 0;
+    size_t digits = 0;
+    int64_t exponent = 0;
+    for (; pos < str->size && (unsigned) ((unsigned char) bytes[pos] - '0') <= 9; ++pos, ++digits) {
+        if (mantissa_digits < 19) {
+            mantissa = mantissa * 10 + (bytes[pos] - '0');
+            mantissa_digits += mantissa != 0;
+        } else {
+            ++mantissa_digits;
+        }
+    }
+    // Digits beyond 19th are not kept in mantissa, so they scale it
+    exponent += mantissa_digits > 19 ? (int64_t) (mantissa_digits - 19) : 0;
+    if (pos < str->size && bytes[pos] == '.') {
+        for (++pos; pos < str->size && (unsigned) ((unsigned char) bytes[pos] - '0') <= 9; ++pos, ++digits) {
+            if (mantissa_digits < 19) {
+                mantissa = mantissa * 10 + (bytes[pos] - '0');
+                mantissa_digits += mantissa != 0;
+                --exponent;
+            } else {
+                ++mantissa_digits;
+            }
+        }
+    }
+    if (digits == 0) {
+        return STRING_T_PARSE_INVALID;
+    }
+    if (pos < str->size && (bytes[pos] == 'e' || bytes[pos] == 'E')) {
+        ++pos;
+        bool_t exponent_negative = pos < str->size && bytes[pos] == '-';
+        if (pos < str->size && (bytes[pos] == '-' || bytes[pos] == '+')) {
+            ++pos;
+        }
+        size_t exponent_start = pos;
+        int64_t exponent_value = 0;
+        for (; pos < str->size && (unsigned) ((unsigned char) bytes[pos] - '0') <= 9; ++pos) {
+            if (exponent_value < 100000) {
+                exponent_value = exponent_value * 10 + (bytes[pos] - '0');
+            }
+        }
+        if (pos == exponent_start) {
+            return STRING_T_PARSE_INVALID;
+        }
+        exponent += exponent_negative ? -exponent_value : exponent_value;
+    }
+    if (pos != str->size) {
+        return STRING_T_PARSE_INVALID;
+    }
+
+    if (mantissa == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return STRING_T_PARSE_OK;
+    }
+    // Clinger's fast path: both mantissa and power of ten are exact doubles
+    if (mantissa_digits <= 19 && mantissa <= ((uint64_t) 1 << 53) && exponent >= -22 && exponent <= 22) {
+        double result = (double) mantissa;
+        if (exponent < 0) {
+            result /= powers[-exponent];
+        } else {
+            result *= powers[exponent];
+        }
+        *value = negative ? -result : result;
+        return STRING_T_PARSE_OK;
+    }
+    return string_t_parse_f64_slow(str, value);
+}
+
+STRING_T_DEF size_t string_parse_i64_arr(STRING_T_ARRAY str_arr, size_t arr_size, int64_t *values) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        if (string_parse_i64(str_arr[idx], values + idx) != STRING_T_PARSE_OK) {
+            return idx;
+        }
+    }
+    return arr_size;
+}
+
+STRING_T_DEF size_t string_parse_u64_arr(STRING_T_ARRAY str_arr, size_t arr_size, uint64_t *values) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        if (string_parse_u64(str_arr[idx], values + idx) != STRING_T_PARSE_OK) {
+            return idx;
+        }
+    }
+    return arr_size;
+}
+
+STRING_T_DEF size_t string_parse_f64_arr(STRING_T_ARRAY str_arr, size_t arr_size, double *values) {
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        if (string_parse_f64(str_arr[idx], values + idx) != STRING_T_PARSE_OK) {
+            return idx;
+        }
+    }
+    return arr_size;
+}
+
+/* Return mask where each bit is xor of all mask's bits up to it (inclusive). */
+STRING_T_DEF uint64_t string_t_prefix_xor64(uint64_t mask) {
+#ifdef STRING_T_PCLMUL
+    __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long) mask), _mm_set1_epi8((char) 0xFF), 0);
+    uint64_t result;
+    // _mm_cvtsi128_si64 is x86-64 only, storing low 64 bits works on 32-bit x86 too
+    _mm_storel_epi64((__m128i *) &result, product);
+    return result;
+#else
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+#endif
+}
+
+/* Index delimiters and newlines of reader's current block, which are not inside quotes. */
+STRING_T_DEF void string_t_csv_index_block(string_csv_t *reader) {
+    const char *block = reader->bytes + reader->block_pos;
+    size_t block_len = reader->size - reader->block_pos < 64 ? reader->size - reader->block_pos : 64;
+
+    uint64_t quotes = string_t_eq_mask64(block, block_len, STRING_T_CSV_QUOTE);
+    uint64_t in_quotes = string_t_prefix_xor64(quotes) ^ reader->in_quotes;
+    uint64_t structurals = string_t_eq_mask64(block, block_len, reader->delimiter) |
+                           string_t_eq_mask64(block, block_len, '\n');
+
+    reader->structurals = structurals & ~in_quotes;
+    reader->in_quotes = (in_quotes >> 63) ? UINT64_MAX : 0;
+}
+
+STRING_T_DEF void string_csv_init(string_csv_t *reader, const string_t *str, char delimiter, bool_t is_last_chunk) {
+    reader->bytes = str->bytes;
+    reader->size = str->size;
+    reader->pos = 0;
+    reader->delimiter = delimiter;
+    reader->is_last_chunk = is_last_chunk;
+    reader->block_pos = 0;
+    reader->structurals = 0;
+    reader->in_quotes = 0;
+    if (str->size > 0) {
+        string_t_csv_index_block(reader);
+    }
+}
+
+/* Set CSV field by its raw bytes bounds. */
+STRING_T_DEF void string_t_csv_set_field(const string_csv_t *reader, string_csv_field_t *field,
+                            size_t start_pos, size_t end_pos, bool_t is_last) {
+    const char *bytes = reader->bytes;
+    if (is_last && end_pos > start_pos && bytes[end_pos - 1] == '\r') {
+        --end_pos;
+    }
+    field->quoted = end_pos > start_pos && bytes[start_pos] == STRING_T_CSV_QUOTE;
+    if (field->quoted) {
+        ++start_pos;
+        if (end_pos > start_pos && bytes[end_pos - 1] == STRING_T_CSV_QUOTE) {
+            --end_pos;
+        }
+    }
+    field->value.bytes = (char *) bytes + start_pos;
+    field->value.size = end_pos - start_pos;
+}
+
+STRING_T_DEF bool_t string_csv_next(string_csv_t *reader, string_csv_field_t *fields, size_t fields_size, size_t *fields_count) {
+    size_t count = 0;
+    size_t field_start = reader->pos;
+    if (reader->pos >= reader->size) {
+        return false;
+    }
+    for (;;) {
+        while (reader->structurals == 0) {
+            if (reader->block_pos + 64 >= reader->size) {
+                if (!reader->is_last_chunk) {
+                    return false;
+                }
+                if (count < fields_size) {
+                    string_t_csv_set_field(reader, fields + count, field_start, reader->size, true);
+                }
+                reader->pos = reader->size;
+                *fields_count = count + 1;
+                return true;
+            }
+            reader->block_pos += 64;
+            string_t_csv_index_block(reader);
+        }
+        size_t pos = reader->block_pos + string_t_ctz64(reader->structurals);
+        reader->structurals &= reader->structurals - 1;
+
+        bool_t is_last = reader->bytes[pos] == '\n';
+        if (count < fields_size) {
+            string_t_csv_set_field(reader, fields + count, field_start, pos, is_last);
+        }
+        ++count;
+        field_start = pos + 1;
+        if (is_last) {
+            reader->pos = pos + 1;
+            *fields_count = count;
+            return true;
+        }
+    }
+}
+
+STRING_T_DEF string_t *string_csv_unescape(const string_csv_field_t *field) {
+    const string_t *value = &field->value;
+    string_t *str = new_string(value->size);
+    if (!field->quoted) {
+        memcpy(str->bytes, value->bytes, value->size);
+        return str;
+    }
+    size_t size = 0;
+    for (size_t pos = 0; pos < value->size; ++pos) {
+        str->bytes[size++] = value->bytes[pos];
+        if (value->bytes[pos] == STRING_T_CSV_QUOTE && pos + 1 < value->size &&
+            value->bytes[pos + 1] == STRING_T_CSV_QUOTE) {
+            ++pos;
+        }
+    }
+    str->bytes[size] = '\0';
+    str->size = size;
+    return str;
+}
+
+STRING_T_DEF string_glob_t *string_glob_compile(const char pattern[]) {
+    string_glob_t *glob = calloc(1, sizeof(string_glob_t));
+    size_t state = 0;
+    for (size_t pos = 0; pattern[pos] != '\0'; ++pos) {
+        if (pattern[pos] == '*') {
+            glob->loops[state / 64] |= (uint64_t) 1 << (state % 64);
+            continue;
+        }
+        if (state + 1 >= STRING_T_GLOB_WORDS * 64) {
+            free(glob);
+            return NULL;
+        }
+        ++state;
+        uint64_t state_bit = (uint64_t) 1 << (state % 64);
+        uint64_t (*accept)[STRING_T_GLOB_WORDS] = glob->accept;
+
+        if (pattern[pos] == '?') {
+            for (size_t byte = 0; byte < 256; ++byte) {
+                accept[byte][state / 64] |= state_bit;
+            }
+        } else if (pattern[pos] == '[') {
+            size_t class_pos = pos + 1;
+            bool_t negate = pattern[class_pos] == '!' || pattern[class_pos] == '^';
+            class_pos += negate;
+            bool_t members[256] = {false};
+            for (size_t first = class_pos; pattern[class_pos] != ']' || class_pos == first; ++class_pos) {
+                if (pattern[class_pos] == '\0') {
+                    free(glob);
+                    return NULL;
+                }
+                unsigned char from = pattern[class_pos];
+                unsigned char to = from;
+                if (pattern[class_pos + 1] == '-' && pattern[class_pos + 2] != ']' && pattern[class_pos + 2] != '\0') {
+                    to = pattern[class_pos + 2];
+                    class_pos += 2;
+                }
+                for (unsigned byte = from; byte <= to; ++byte) {
+                    members[byte] = true;
+                }
+            }
+            for (size_t byte = 0; byte < 256; ++byte) {
+                if (members[byte] != negate) {
+                    accept[byte][state / 64] |= state_bit;
+                }
+            }
+            pos = class_pos;
+        } else {
+            if (pattern[pos] == '\\' && pattern[pos + 1] != '\0') {
+                ++pos;
+            }
+            accept[(unsigned char) pattern[pos]][state / 64] |= state_bit;
+        }
+    }
+    glob->final_state = state;
+    glob->words = state / 64 + 1;
+    return glob;
+}
+
+STRING_T_DEF bool_t string_glob_match(const string_glob_t *glob, const string_t *str) {
+    uint64_t states[STRING_T_GLOB_WORDS] = {1};
+    size_t final_word = glob->final_state / 64;
+    uint64_t final_bit = (uint64_t) 1 << (glob->final_state % 64);
+    bool_t final_loops = (glob->loops[final_word] & final_bit) != 0;
+
+    for (size_t pos = 0; pos < str->size; ++pos) {
+        const uint64_t *accept = glob->accept[(unsigned char) str->bytes[pos]];
+        uint64_t carry = 0;
+        uint64_t active = 0;
+        for (size_t word = 0; word < glob->words; ++word) {
+            uint64_t shifted = (states[word] << 1) | carry;
+            carry = states[word] >> 63;
+            states[word] = (shifted & accept[word]) | (states[word] & glob->loops[word]);
+            active |= states[word];
+        }
+        if (active == 0) {
+            return false;
+        }
+        if (final_loops && (states[final_word] & final_bit)) {
+            return true;
+        }
+    }
+    return (states[final_word] & final_bit) != 0;
+}
+
+STRING_T_DEF void string_glob_free(string_glob_t *glob) {
+    free(glob);
+}
+
+/*
+ * Blocked Myers/Hyyro bit-parallel edit distance between pattern and text, 64 pattern's chars per word.
+ * With free_start text's prefix is skipped for free (approximate search). With stop_on_match it stops at
+ * the first text's column where distance is not greater than max_distance, otherwise it stops as soon as
+ * the distance can't become less than max_distance. Return distance at the last processed column.
+ */
+STRING_T_DEF size_t string_t_myers(const char *pattern, size_t pattern_len, const char *text, size_t text_len, bool_t reverse,
+                      bool_t free_start, bool_t stop_on_match, size_t max_distance, size_t *columns) {
+    size_t blocks = (pattern_len + 63) / 64;
+    uint64_t stack_words[256 + 2];
+    uint64_t *peq = blocks == 1 ? stack_words : calloc((256 + 2) * blocks, sizeof(uint64_t));
+    uint64_t *pv = peq + 256 * blocks;
+    uint64_t *mv = pv + blocks;
+
+    memset(peq, 0, 256 * blocks * sizeof(uint64_t));
+    for (size_t idx = 0; idx < pattern_len; ++idx) {
+        unsigned char byte = pattern[reverse ? pattern_len - 1 - idx : idx];
+        peq[byte * blocks + idx / 64] |= (uint64_t) 1 << (idx % 64);
+    }
+    for (size_t block = 0; block < blocks; ++block) {
+        pv[block] = UINT64_MAX;
+        mv[block] = 0;
+    }
+
+    int last_bit = (int) ((pattern_len - 1) % 64);
+    size_t score = pattern_len;
+    size_t column = 0;
+    while (column < text_len) {
+        unsigned char byte = text[reverse ? text_len - 1 - column : column];
+        const uint64_t *byte_peq = peq + byte * blocks;
+        int hin = free_start ? 0 : 1;
+        for (size_t block = 0; block < blocks; ++block) {
+            uint64_t hin_neg = hin < 0;
+            uint64_t eq = byte_peq[block];
+            uint64_t xv = eq | mv[block];
+            eq |= hin_neg;
+            uint64_t xh = (((eq & pv[block]) + pv[block]) ^ pv[block]) | eq;
+            uint64_t ph = mv[block] | ~(xh | pv[block]);
+            uint64_t mh = pv[block] & xh;
+
+            int out_bit = block == blocks - 1 ? last_bit : 63;
+            int hout = (int) ((ph >> out_bit) & 1) - (int) ((mh >> out_bit) & 1);
+            ph = (ph << 1) | (hin > 0);
+            mh = (mh << 1) | hin_neg;
+            pv[block] = mh | ~(xv | ph);
+            mv[block] = ph & xv;
+            hin = hout;
+        }
+        score += hin;
+        ++column;
+        if (stop_on_match ? score <= max_distance
+                          : score > max_distance && score - max_distance > text_len - column) {
+            break;
+        }
+    }
+
+    if (peq != stack_words) {
+        free(peq);
+    }
+    if (columns) {
+        *columns = column;
+    }
+    return score;
+}
+
+STRING_T_DEF size_t string_levenshtein(const string_t *first, const string_t *second) {
+    const string_t *pattern = first->size <= second->size ? first : second;
+    const string_t *text = first->size <= second->size ? second : first;
+    if (pattern->size == 0) {
+        return text->size;
+    }
+    return string_t_myers(pattern->bytes, pattern->size, text->bytes, text->size,
+                          false, false, false, (size_t) -1, NULL);
+}
+
+STRING_T_DEF bool_t string_levenshtein_within(const string_t *first, const string_t *second, size_t max_distance) {
+    const string_t *pattern = first->size <= second->size ? first : second;
+    const string_t *text = first->size <= second->size ? second : first;
+    if (text->size - pattern->size > max_distance) {
+        return false;
+    }
+    if (pattern->size == 0) {
+        return true;
+    }
+    return string_t_myers(pattern->bytes, pattern->size, text->bytes, text->size,
+                          false, false, false, max_distance, NULL) <= max_distance;
+}
+
+STRING_T_DEF int string_fuzzy_find(const string_t *str, const char chars[], size_t max_distance) {
+    size_t chars_len = strlen(chars);
+    if (chars_len <= max_distance) {
+        return 0;
+    }
+    size_t end_pos;
+    if (string_t_myers(chars, chars_len, str->bytes, str->size, false, true, true, max_distance, &end_pos) >
+        max_distance) {
+        return -1;
+    }
+    // Occurrence ends at end_pos, so search its start matching reversed chars from there
+    size_t len;
+    string_t_myers(chars, chars_len, str->bytes, end_pos, true, false, true, max_distance, &len);
+    return (int) (end_pos - len);
+}
+
+STRING_T_DEF size_t string_base64_encoded_len(size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+#ifdef STRING_T_SSSE3
+/* Encode 12 bytes (of 16 loaded) into 16 base64 chars. */
+STRING_T_DEF __m128i string_t_base64_encode_sse(__m128i input) {
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i high_sextets = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)),
+                                           _mm_set1_epi32(0x04000040));
+    __m128i low_sextets = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)),
+                                          _mm_set1_epi32(0x01000010));
+    __m128i sextets = _mm_or_si128(high_sextets, low_sextets);
+
+    const __m128i shifts = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i shift_idx = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    shift_idx = _mm_or_si128(shift_idx, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(shifts, shift_idx));
+}
+
+/* Decode 16 base64 chars into 12 bytes (of 16 stored). Return false(0) if any char is invalid. */
+STRING_T_DEF bool_t string_t_base64_decode_sse(__m128i input, __m128i *output) {
+    const __m128i shifts = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i valid_masks = _mm_setr_epi8((char) 0xA8, (char) 0xF8, (char) 0xF8, (char) 0xF8, (char) 0xF8,
+                                              (char) 0xF8, (char) 0xF8, (char) 0xF8, (char) 0xF8, (char) 0xF8,
+                                              (char) 0xF0, 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m128i high_bits = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char) 0x80,
+                                            0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i high_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0F));
+    __m128i low_nibbles = _mm_and_si128(input, _mm_set1_epi8(0x0F));
+
+    __m128i valid_bits = _mm_and_si128(_mm_shuffle_epi8(valid_masks, low_nibbles),
+                                       _mm_shuffle_epi8(high_bits, high_nibbles));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid_bits, _mm_setzero_si128())) != 0) {
+        return false;
+    }
+    __m128i is_slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+    __m128i shift = _mm_or_si128(_mm_andnot_si128(is_slash, _mm_shuffle_epi8(shifts, high_nibbles)),
+                                 _mm_and_si128(is_slash, _mm_set1_epi8(16)));
+    __m128i sextets = _mm_add_epi8(input, shift);
+
+    __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    *output = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    return true;
+}
+#endif
+
+STRING_T_DEF size_t string_base64_encode_to(const string_t *str, char *buffer) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const unsigned char *bytes = (const unsigned char *) str->bytes;
+    size_t pos = 0;
+    size_t out_pos = 0;
+#ifdef STRING_T_SSSE3
+    for (; pos + 16 <= str->size; pos += 12, out_pos += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i *) (bytes + pos));
+        _mm_storeu_si128((__m128i *) (buffer + out_pos), string_t_base64_encode_sse(input));
+    }
+#endif
+    for (; pos + 3 <= str->size; pos += 3, out_pos += 4) {
+        uint32_t triple = (uint32_t) bytes[pos] << 16 | (uint32_t) bytes[pos + 1] << 8 | bytes[pos + 2];
+        buffer[out_pos] = alphabet[triple >> 18];
+        buffer[out_pos + 1] = alphabet[(triple >> 12) & 0x3F];
+        buffer[out_pos + 2] = alphabet[(triple >> 6) & 0x3F];
+        buffer[out_pos + 3] = alphabet[triple & 0x3F];
+    }
+    if (pos < str->size) {
+        uint32_t triple = (uint32_t) bytes[pos] << 16;
+        if (pos + 1 < str->size) {
+            triple |= (uint32_t) bytes[pos + 1] << 8;
+        }
+        buffer[out_pos] = alphabet[triple >> 18];
+        buffer[out_pos + 1] = alphabet[(triple >> 12) & 0x3F];
+        buffer[out_pos + 2] = pos + 1 < str->size ? alphabet[(triple >> 6) & 0x3F] : '=';
+        buffer[out_pos + 3] = '=';
+        out_pos += 4;
+    }
+    return out_pos;
+}
+
+STRING_T_DEF string_t *string_base64_encode(const string_t *str) {
+    string_t *encoded_str = new_string(string_base64_encoded_len(str->size));
+    string_base64_encode_to(str, encoded_str->bytes);
+    return encoded_str;
+}
+
+STRING_T_DEF size_t string_base64_decoded_len(const string_t *str) {
+    if (str->size == 0 || str->size % 4 != 0) {
+        return 0;
+    }
+    size_t padding = (str->bytes[str->size - 1] == '=') + (str->bytes[str->size - 2] == '=');
+    return str->size / 4 * 3 - padding;
+}
+
+STRING_T_DEF bool_t string_base64_decode_to(const string_t *str, char *buffer, size_t *written) {
+    static const signed char sextets[256] = {
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+            52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+            -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+            15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+            -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+            41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    };
+    if (str->size % 4 != 0) {
+        return false;
+    }
+    const unsigned char *bytes = (const unsigned char *) str->bytes;
+    size_t pos = 0;
+    size_t out_pos = 0;
+#ifdef STRING_T_SSSE3
+    // Decoded block is stored as 16 bytes, so at least 4 more bytes must follow it in buffer
+    for (; pos + 24 <= str->size; pos += 16, out_pos += 12) {
+        __m128i output;
+        if (!string_t_base64_decode_sse(_mm_loadu_si128((const __m128i *) (bytes + pos)), &output)) {
+            return false;
+        }
+        _mm_storeu_si128((__m128i *) (buffer + out_pos), output);
+    }
+#endif
+    for (; pos < str->size; pos += 4) {
+        int first = sextets[bytes[pos]];
+        int second = sextets[bytes[pos + 1]];
+        int third = sextets[bytes[pos + 2]];
+        int fourth = sextets[bytes[pos + 3]];
+        bool_t is_last = pos + 4 == str->size;
+
+        if (is_last && bytes[pos + 3] == '=') {
+            if (first < 0 || second < 0) {
+                return false;
+            }
+            buffer[out_pos++] = (char) (first << 2 | second >> 4);
+            if (bytes[pos + 2] == '=') {
+                if (second & 0x0F) {
+                    return false;
+                }
+                break;
+            }
+            if (third < 0 || (third & 0x03)) {
+                return false;
+            }
+            buffer[out_pos++] = (char) ((second & 0x0F) << 4 | third >> 2);
+            break;
+        }
+        if ((first | second | third | fourth) < 0) {
+            return false;
+        }
+        uint32_t triple = (uint32_t) first << 18 | (uint32_t) second << 12 | (uint32_t) third << 6 | fourth;
+        buffer[out_pos] = (char) (triple >> 16);
+        buffer[out_pos + 1] = (char) (triple >> 8);
+        buffer[out_pos + 2] = (char) triple;
+        out_pos += 3;
+    }
+    *written = out_pos;
+    return true;
+}
+
+STRING_T_DEF string_t *string_base64_decode(const string_t *str) {
+    string_t *decoded_str = new_string(string_base64_decoded_len(str));
+    if (!string_base64_decode_to(str, decoded_str->bytes, &decoded_str->size)) {
+        string_free(decoded_str);
+        return NULL;
+    }
+    return decoded_str;
+}
+
+#ifdef STRING_T_SSE2
+/* Convert 16 nibbles into lower case hex chars. */
+STRING_T_DEF __m128i string_t_hex_chars_sse(__m128i nibbles) {
+    __m128i is_letter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    __m128i chars = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(chars, _mm_and_si128(is_letter, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+/* Convert 16 hex chars into nibbles. Return false(0) if any char is invalid. */
+STRING_T_DEF bool_t string_t_hex_nibbles_sse(__m128i chars, __m128i *nibbles) {
+    __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF) {
+        return false;
+    }
+    *nibbles = _mm_or_si128(_mm_and_si128(is_digit, digits),
+                            _mm_and_si128(is_letter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+    return true;
+}
+
+/* Pack 16 nibbles pairs (high nibble first) into 8 bytes of 16-bit lanes. */
+STRING_T_DEF __m128i string_t_hex_pack_sse(__m128i nibbles) {
+    __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+#endif
+
+STRING_T_DEF size_t string_hex_encode_to(const string_t *str, char *buffer) {
+    static const char digits[] = "0123456789abcdef";
+    const unsigned char *bytes = (const unsigned char *) str->bytes;
+    size_t pos = 0;
+#ifdef STRING_T_SSE2
+    for (; pos + 16 <= str->size; pos += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i *) (bytes + pos));
+        __m128i high = string_t_hex_chars_sse(_mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F)));
+        __m128i low = string_t_hex_chars_sse(_mm_and_si128(input, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i *) (buffer + pos * 2), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *) (buffer + pos * 2 + 16), _mm_unpackhi_epi8(high, low));
+    }
+#endif
+    for (; pos < str->size; ++pos) {
+        buffer[pos * 2] = digits[bytes[pos] >> 4];
+        buffer[pos * 2 + 1] = digits[bytes[pos] & 0x0F];
+    }
+    return str->size * 2;
+}
+
+STRING_T_DEF string_t *string_hex_encode(const string_t *str) {
+    string_t *encoded_str = new_string(str->size * 2);
+    string_hex_encode_to(str, encoded_str->bytes);
+    return encoded_str;
+}
+
+/* Return hex char value or -1 if char is not hex digit. */
+STRING_T_DEF int string_t_hex_value(char byte) {
+    if (byte >= '0' && byte <= '9') {
+        return byte - '0';
+    }
+    byte |= 0x20;
+    return byte >= 'a' && byte <= 'f' ? byte - 'a' + 10 : -1;
+}
+
+STRING_T_DEF bool_t string_hex_decode_to(const string_t *str, char *buffer, size_t *written) {
+    if (str->size % 2 != 0) {
+        return false;
+    }
+    size_t pos = 0;
+#ifdef STRING_T_SSE2
+    for (; pos + 32 <= str->size; pos += 32) {
+        __m128i first, second;
+        if (!string_t_hex_nibbles_sse(_mm_loadu_si128((const __m128i *) (str->bytes + pos)), &first) ||
+            !string_t_hex_nibbles_sse(_mm_loadu_si128((const __m128i *) (str->bytes + pos + 16)), &second)) {
+            return false;
+        }
+        __m128i output = _mm_packus_epi16(string_t_hex_pack_sse(first), string_t_hex_pack_sse(second));
+        _mm_storeu_si128((__m128i *) (buffer + pos / 2), output);
+    }
+#endif
+    for (; pos < str->size; pos += 2) {
+        int high = string_t_hex_value(str->bytes[pos]);
+        int low = string_t_hex_value(str->bytes[pos + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        buffer[pos / 2] = (char) (high << 4 | low);
+    }
+    *written = str->size / 2;
+    return true;
+}
+
+STRING_T_DEF string_t *string_hex_decode(const string_t *str) {
+    string_t *decoded_str = new_string(str->size / 2);
+    if (!string_hex_decode_to(str, decoded_str->bytes, &decoded_str->size)) {
+        string_free(decoded_str);
+        return NULL;
+    }
+    return decoded_str;
+}
+
+/* Compare 2 strings views for sorting. */
+STRING_T_DEF int string_t_view_cmp(const void *left, const void *right) {
+    return string_compare(left, right);
+}
+
+/* Build compressed radix trie of given strings, reversed if is_suffix. */
+STRING_T_DEF string_prefix_set_t *string_t_new_trie(const char *strings[], size_t count, bool_t is_suffix) {
+    string_prefix_set_t *set = malloc(sizeof(string_prefix_set_t));
+    string_t *entries = calloc(count + 1, sizeof(string_t));
+
+    size_t bytes_size = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        entries[idx].size = strlen(strings[idx]);
+        bytes_size += entries[idx].size;
+    }
+    set->bytes = malloc(bytes_size + 1);
+    set->is_suffix = is_suffix;
+    size_t offset = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        entries[idx].bytes = set->bytes + offset;
+        for (size_t pos = 0; pos < entries[idx].size; ++pos) {
+            entries[idx].bytes[pos] = strings[idx][is_suffix ? entries[idx].size - 1 - pos : pos];
+        }
+        offset += entries[idx].size;
+    }
+    qsort(entries, count, sizeof(string_t), string_t_view_cmp);
+
+    // Every string adds at most 2 nodes; nodes are built breadth-first, so the array is the queue
+    size_t nodes_size = 2 * count + 1;
+    set->nodes = calloc(nodes_size, sizeof(string_t_trie_node_t));
+    set->child_keys = calloc(nodes_size, sizeof(unsigned char));
+    size_t *ranges = calloc(nodes_size * 3, sizeof(size_t));
+    ranges[1] = count;
+    set->nodes_count = 1;
+
+    for (size_t node_idx = 0; node_idx < set->nodes_count; ++node_idx) {
+        string_t_trie_node_t *node = set->nodes + node_idx;
+        size_t lo = ranges[node_idx * 3];
+        size_t hi = ranges[node_idx * 3 + 1];
+        size_t depth = ranges[node_idx * 3 + 2];
+
+        for (; lo < hi && entries[lo].size == depth; ++lo) {
+            node->is_terminal = true;
+        }
+        node->first_child = set->nodes_count;
+        while (lo < hi) {
+            unsigned char byte = entries[lo].bytes[depth];
+            size_t group_hi = lo + 1;
+            for (; group_hi < hi && (unsigned char) entries[group_hi].bytes[depth] == byte; ++group_hi);
+
+            const string_t *first = entries + lo;
+            const string_t *last = entries + group_hi - 1;
+            size_t common_len = depth + 1;
+            for (; common_len < first->size && common_len < last->size &&
+                   first->bytes[common_len] == last->bytes[common_len]; ++common_len);
+
+            size_t child_idx = set->nodes_count++;
+            set->nodes[child_idx].label_pos = (size_t) (first->bytes + depth - set->bytes);
+            set->nodes[child_idx].label_len = common_len - depth;
+            set->child_keys[child_idx] = byte;
+            ranges[child_idx * 3] = lo;
+            ranges[child_idx * 3 + 1] = group_hi;
+            ranges[child_idx * 3 + 2] = common_len;
+            ++node->children_count;
+            lo = group_hi;
+        }
+    }
+
+    free(ranges);
+    free(entries);
+    return set;
+}
+
+STRING_T_DEF string_prefix_set_t *new_string_prefix_set(const char *prefixes[], size_t count) {
+    return string_t_new_trie(prefixes, count, false);
+}
+
+STRING_T_DEF string_prefix_set_t *new_string_suffix_set(const char *suffixes[], size_t count) {
+    return string_t_new_trie(suffixes, count, true);
+}
+
+/* Walk trie by string's bytes and return length of the first (or the longest) matched set's string. */
+STRING_T_DEF int string_t_trie_match(const string_prefix_set_t *set, const string_t *str, bool_t longest) {
+    const string_t_trie_node_t *node = set->nodes;
+    int match = node->is_terminal ? 0 : -1;
+    size_t pos = 0;
+    while (pos < str->size && !(match >= 0 && !longest)) {
+        unsigned char byte = str->bytes[set->is_suffix ? str->size - 1 - pos : pos];
+        const unsigned char *child_key = memchr(set->child_keys + node->first_child, byte, node->children_count);
+        if (child_key == NULL) {
+            break;
+        }
+        node = set->nodes + (child_key - set->child_keys);
+
+        if (node->label_len > str->size - pos) {
+            break;
+        }
+        const char *label = set->bytes + node->label_pos;
+        if (!set->is_suffix) {
+            if (memcmp(label + 1, str->bytes + pos + 1, node->label_len - 1) != 0) {
+                break;
+            }
+        } else {
+            size_t idx = 1;
+            for (; idx < node->label_len && label[idx] == str->bytes[str->size - 1 - pos - idx]; ++idx);
+            if (idx < node->label_len) {
+                break;
+            }
+        }
+        pos += node->label_len;
+        if (node->is_terminal) {
+            match = (int) pos;
+        }
+    }
+    return match;
+}
+
+STRING_T_DEF int string_prefix_set_longest_match(const string_prefix_set_t *set, const string_t *str) {
+    return string_t_trie_match(set, str, true);
+}
+
+STRING_T_DEF bool_t string_prefix_set_any_match(const string_prefix_set_t *set, const string_t *str) {
+    return string_t_trie_match(set, str, false) >= 0;
+}
+
+STRING_T_DEF void string_prefix_set_free(string_prefix_set_t *set) {
+    free(set->nodes);
+    free(set->child_keys);
+    free(set->bytes);
+    free(set);
+}
+
+/* Sorted string with cached 8 bytes of its key at current depth and count of them within string. */
+typedef struct string_t_sort_item_t {
+    uint64_t cache;
+    size_t cached_len;
+    string_t *str;
+} string_t_sort_item_t;
+
+/* Cache string's 8 bytes starting at depth as big endian number, so numbers order is bytes order. */
+STRING_T_DEF void string_t_sort_load(string_t_sort_item_t *item, size_t depth) {
+    const string_t *str = item->str;
+    size_t rest = str->size > depth ? str->size - depth : 0;
+    item->cached_len = rest < 8 ? rest : 8;
+    item->cache = 0;
+    for (size_t idx = 0; idx < item->cached_len; ++idx) {
+        item->cache |= (uint64_t) (unsigned char) str->bytes[depth + idx] << (56 - idx * 8);
+    }
+}
+
+/* Compare items by cached keys. Equal keys with 8 cached bytes may differ deeper. */
+STRING_T_DEF int string_t_sort_key_cmp(const string_t_sort_item_t *left, const string_t_sort_item_t *right) {
+    if (left->cache != right->cache) {
+        return left->cache < right->cache ? -1 : 1;
+    }
+    return (left->cached_len > right->cached_len) - (left->cached_len < right->cached_len);
+}
+
+/* Compare items, which strings are equal before depth. */
+STRING_T_DEF int string_t_sort_cmp(const string_t_sort_item_t *left, const string_t_sort_item_t *right, size_t depth) {
+    int res = string_t_sort_key_cmp(left, right);
+    if (res != 0 || left->cached_len < 8) {
+        return res;
+    }
+    string_t left_rest = {left->str->bytes + depth + 8, left->str->size - depth - 8};
+    string_t right_rest = {right->str->bytes + depth + 8, right->str->size - depth - 8};
+    return string_compare(&left_rest, &right_rest);
+}
+
+/* Return item with median key of 3 items. */
+STRING_T_DEF const string_t_sort_item_t *string_t_sort_median3(const string_t_sort_item_t *first,
+                                                  const string_t_sort_item_t *middle,
+                                                  const string_t_sort_item_t *last) {
+    return string_t_sort_key_cmp(first, middle) < 0
+           ? (string_t_sort_key_cmp(middle, last) < 0 ? middle : string_t_sort_key_cmp(first, last) < 0 ? last : first)
+           : (string_t_sort_key_cmp(first, last) < 0 ? first : string_t_sort_key_cmp(middle, last) < 0 ? last : middle);
+}
+
+/* Return partitioning steps allowed for items count before falling back to heapsort. */
+STRING_T_DEF size_t string_t_sort_depth_limit(size_t count) {
+    size_t limit = 0;
+    for (; count > 1; count >>= 1, limit += 2);
+    return limit;
+}
+
+/* Move item at root down the max heap of items, which strings are equal before depth. */
+STRING_T_DEF void string_t_sort_sift_down(string_t_sort_item_t *items, size_t root, size_t count, size_t depth) {
+    string_t_sort_item_t item = items[root];
+    for (size_t child = root * 2 + 1; child < count; child = root * 2 + 1) {
+        if (child + 1 < count && string_t_sort_cmp(items + child, items + child + 1, depth) < 0) {
+            ++child;
+        }
+        if (string_t_sort_cmp(&item, items + child, depth) >= 0) {
+            break;
+        }
+        items[root] = items[child];
+        root = child;
+    }
+    items[root] = item;
+}
+
+/* Heapsort items, which strings are equal before depth. Used when quicksort's partitions are unbalanced. */
+STRING_T_DEF void string_t_sort_heapsort(string_t_sort_item_t *items, size_t count, size_t depth) {
+    for (size_t idx = count / 2; idx > 0; --idx) {
+        string_t_sort_sift_down(items, idx - 1, count, depth);
+    }
+    for (size_t end = count - 1; end > 0; --end) {
+        string_t_sort_item_t item = items[0];
+        items[0] = items[end];
+        items[end] = item;
+        string_t_sort_sift_down(items, 0, end, depth);
+    }
+}
+
+/*
+ * Multikey quicksort of items, which strings are equal before depth and have keys cached at it.
+ * Only the smaller partitions are sorted recursively, so stack depth is O(log n), and after limit
+ * partitioning steps the rest is heapsorted as in introsort.
+ */
+STRING_T_DEF void string_t_mkqs(string_t_sort_item_t *items, size_t count, size_t depth, size_t limit) {
+    while (count > 1) {
+        if (count < 16) {
+            for (size_t idx = 1; idx < count; ++idx) {
+                string_t_sort_item_t item = items[idx];
+                size_t pos = idx;
+                for (; pos > 0 && string_t_sort_cmp(&item, items + pos - 1, depth) < 0; --pos) {
+                    items[pos] = items[pos - 1];
+                }
+                items[pos] = item;
+            }
+            return;
+        }
+        if (limit == 0) {
+            string_t_sort_heapsort(items, count, depth);
+            return;
+        }
+        --limit;
+
+        const string_t_sort_item_t *median;
+        if (count < 128) {
+            median = string_t_sort_median3(items, items + count / 2, items + count - 1);
+        } else {
+            // Ninther: median of 3 medians of 3
+            size_t step = count / 8;
+            const string_t_sort_item_t *middle = items + count / 2;
+            const string_t_sort_item_t *last = items + count - 1;
+            median = string_t_sort_median3(string_t_sort_median3(items, items + step, items + 2 * step),
+                                           string_t_sort_median3(middle - step, middle, middle + step),
+                                           string_t_sort_median3(last - 2 * step, last - step, last));
+        }
+        string_t_sort_item_t pivot = *median;
+
+        size_t less_end = 0;
+        size_t greater_start = count;
+        for (size_t idx = 0; idx < greater_start;) {
+            int res = string_t_sort_key_cmp(items + idx, &pivot);
+            string_t_sort_item_t item = items[idx];
+            if (res < 0) {
+                items[idx++] = items[less_end];
+                items[less_end++] = item;
+            } else if (res > 0) {
+                items[idx] = items[--greater_start];
+                items[greater_start] = item;
+            } else {
+                ++idx;
+            }
+        }
+
+        // Equal keys shorter than 8 bytes mean equal strings, the others continue at the next depth
+        size_t equal_count = pivot.cached_len < 8 ? 0 : greater_start - less_end;
+        size_t greater_count = count - greater_start;
+        for (size_t idx = less_end; idx < less_end + equal_count; ++idx) {
+            string_t_sort_load(items + idx, depth + 8);
+        }
+        if (equal_count >= less_end && equal_count >= greater_count) {
+            string_t_mkqs(items, less_end, depth, limit);
+            string_t_mkqs(items + greater_start, greater_count, depth, limit);
+            items += less_end;
+            count = equal_count;
+            depth += 8;
+            limit = string_t_sort_depth_limit(count);
+        } else if (less_end >= greater_count) {
+            string_t_mkqs(items + less_end, equal_count, depth + 8, string_t_sort_depth_limit(equal_count));
+            string_t_mkqs(items + greater_start, greater_count, depth, limit);
+            count = less_end;
+        } else {
+            string_t_mkqs(items, less_end, depth, limit);
+            string_t_mkqs(items + less_end, equal_count, depth + 8, string_t_sort_depth_limit(equal_count));
+            items += greater_start;
+            count = greater_count;
+        }
+    }
+}
+
+STRING_T_DEF void string_array_sort(STRING_T_ARRAY str_arr, size_t arr_size) {
+    if (arr_size < 2) {
+        return;
+    }
+    string_t_sort_item_t *items = malloc(arr_size * sizeof(string_t_sort_item_t));
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        items[idx].str = str_arr[idx];
+        string_t_sort_load(items + idx, 0);
+    }
+    string_t_mkqs(items, arr_size, 0, string_t_sort_depth_limit(arr_size));
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        str_arr[idx] = items[idx].str;
+    }
+    free(items);
+}
+
+STRING_T_DEF size_t string_array_sort_unique(STRING_T_ARRAY str_arr, size_t arr_size) {
+    string_array_sort(str_arr, arr_size);
+    size_t unique_size = 0;
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        if (unique_size > 0 && string_eq(str_arr[unique_size - 1], str_arr[idx])) {
+            string_free(str_arr[idx]);
+        } else {
+            str_arr[unique_size++] = str_arr[idx];
+        }
+    }
+    return unique_size;
+}
+
+/* Return size of number encoded as varint. */
+STRING_T_DEF size_t string_t_varint_len(size_t value) {
+    size_t len = 1;
+    for (; value >= 0x80; value >>= 7, ++len);
+    return len;
+}
+
+/* Write number as varint. Return written size. */
+STRING_T_DEF size_t string_t_varint_write(unsigned char *bytes, size_t value) {
+    size_t len = 0;
+    for (; value >= 0x80; value >>= 7) {
+        bytes[len++] = (unsigned char) (value | 0x80);
+    }
+    bytes[len++] = (unsigned char) value;
+    return len;
+}
+
+/* Read varint number. Return read size. */
+STRING_T_DEF size_t string_t_varint_read(const unsigned char *bytes, size_t *value) {
+    size_t len = 0;
+    size_t result = 0;
+    for (; bytes[len] & 0x80; ++len) {
+        result |= (size_t) (bytes[len] & 0x7F) << (len * 7);
+    }
+    result |= (size_t) bytes[len] << (len * 7);
+    *value = result;
+    return len + 1;
+}
+
+/* Return length of common prefix of 2 strings. */
+STRING_T_DEF size_t string_t_common_prefix_len(const string_t *left, const string_t *right) {
+    size_t len = left->size < right->size ? left->size : right->size;
+    size_t pos = 0;
+    for (; pos < len && left->bytes[pos] == right->bytes[pos]; ++pos);
+    return pos;
+}
+
+STRING_T_DEF string_fc_array_t *new_string_fc_array(STRING_T_ARRAY str_arr, size_t arr_size, size_t bucket_size) {
+    bucket_size = bucket_size == 0 ? STRING_T_FC_BUCKET_SIZE : bucket_size;
+    size_t bytes_size = 0;
+    size_t max_len = 0;
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        const string_t *str = str_arr[idx];
+        max_len = str->size > max_len ? str->size : max_len;
+        if (idx > 0 && string_compare(str_arr[idx - 1], str) > 0) {
+            return NULL;
+        }
+        if (idx % bucket_size == 0) {
+            bytes_size += string_t_varint_len(str->size) + str->size;
+            continue;
+        }
+        size_t shared_len = string_t_common_prefix_len(str_arr[idx - 1], str);
+        bytes_size += string_t_varint_len(shared_len) + string_t_varint_len(str->size - shared_len);
+        bytes_size += str->size - shared_len;
+    }
+
+    string_fc_array_t *arr = malloc(sizeof(string_fc_array_t));
+    arr->bytes = malloc(bytes_size + 1);
+    arr->bucket_offsets = malloc(((arr_size + bucket_size - 1) / bucket_size + 1) * sizeof(size_t));
+    arr->size = arr_size;
+    arr->bucket_size = bucket_size;
+    arr->max_len = max_len;
+
+    size_t offset = 0;
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        const string_t *str = str_arr[idx];
+        size_t shared_len = 0;
+        if (idx % bucket_size == 0) {
+            arr->bucket_offsets[idx / bucket_size] = offset;
+        } else {
+            shared_len = string_t_common_prefix_len(str_arr[idx - 1], str);
+            offset += string_t_varint_write(arr->bytes + offset, shared_len);
+        }
+        offset += string_t_varint_write(arr->bytes + offset, str->size - shared_len);
+        memcpy(arr->bytes + offset, str->bytes + shared_len, str->size - shared_len);
+        offset += str->size - shared_len;
+    }
+    return arr;
+}
+
+STRING_T_DEF size_t string_fc_array_len(const string_fc_array_t *arr) {
+    return arr->size;
+}
+
+/* Return bucket's first string as view over array's bytes and set position after it. */
+STRING_T_DEF string_t string_t_fc_bucket_head(const string_fc_array_t *arr, size_t bucket, size_t *pos) {
+    string_t head;
+    size_t offset = arr->bucket_offsets[bucket];
+    offset += string_t_varint_read(arr->bytes + offset, &head.size);
+    head.bytes = (char *) arr->bytes + offset;
+    if (pos) {
+        *pos = offset + head.size;
+    }
+    return head;
+}
+
+/* Decode bucket's next string at position into buffer, which holds the previous one. Return new position. */
+STRING_T_DEF size_t string_t_fc_decode_next(const string_fc_array_t *arr, size_t pos, char *buffer, size_t *len) {
+    size_t shared_len, rest_len;
+    pos += string_t_varint_read(arr->bytes + pos, &shared_len);
+    pos += string_t_varint_read(arr->bytes + pos, &rest_len);
+    memcpy(buffer + shared_len, arr->bytes + pos, rest_len);
+    *len = shared_len + rest_len;
+    return pos + rest_len;
+}
+
+STRING_T_DEF size_t string_fc_array_get(const string_fc_array_t *arr, size_t idx, char *buffer) {
+    size_t pos;
+    string_t head = string_t_fc_bucket_head(arr, idx / arr->bucket_size, &pos);
+    memcpy(buffer, head.bytes, head.size);
+    size_t len = head.size;
+    for (size_t bucket_idx = 0; bucket_idx < idx % arr->bucket_size; ++bucket_idx) {
+        pos = string_t_fc_decode_next(arr, pos, buffer, &len);
+    }
+    buffer[len] = '\0';
+    return len;
+}
+
+STRING_T_DEF string_t *string_fc_array_at(const string_fc_array_t *arr, size_t idx) {
+    string_t *str = new_string(arr->max_len);
+    str->size = string_fc_array_get(arr, idx, str->bytes);
+    return str;
+}
+
+/* Return count of strings less than given one and set whether the next string is equal to it. */
+STRING_T_DEF size_t string_t_fc_rank(const string_fc_array_t *arr, const string_t *str, bool_t *found) {
+    size_t buckets_count = (arr->size + arr->bucket_size - 1) / arr->bucket_size;
+    size_t lo = 0;
+    size_t hi = buckets_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        string_t head = string_t_fc_bucket_head(arr, mid, NULL);
+        if (string_compare(&head, str) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = false;
+    if (lo == 0) {
+        if (arr->size > 0) {
+            string_t head = string_t_fc_bucket_head(arr, 0, NULL);
+            *found = string_eq(&head, str);
+        }
+        return 0;
+    }
+
+    // Scan the last bucket with head less than string, tracking common prefix with the previous string
+    size_t bucket = lo - 1;
+    size_t pos;
+    string_t head = string_t_fc_bucket_head(arr, bucket, &pos);
+    size_t matched_len = string_t_common_prefix_len(&head, str);
+    size_t bucket_len = arr->size - bucket * arr->bucket_size;
+    bucket_len = bucket_len < arr->bucket_size ? bucket_len : arr->bucket_size;
+
+    size_t count = 1;
+    for (; count < bucket_len; ++count) {
+        size_t shared_len, rest_len;
+        pos += string_t_varint_read(arr->bytes + pos, &shared_len);
+        pos += string_t_varint_read(arr->bytes + pos, &rest_len);
+        string_t rest = {(char *) arr->bytes + pos, rest_len};
+        pos += rest_len;
+        if (shared_len < matched_len) {
+            break;
+        }
+        if (shared_len == matched_len) {
+            string_t str_rest = {str->bytes + matched_len, str->size - matched_len};
+            size_t rest_matched_len = string_t_common_prefix_len(&rest, &str_rest);
+            if (string_compare(&rest, &str_rest) >= 0) {
+                *found = rest.size == str_rest.size && rest_matched_len == rest.size;
+                return bucket * arr->bucket_size + count;
+            }
+            matched_len += rest_matched_len;
+        }
+    }
+    if (count < bucket_len) {
+        return bucket * arr->bucket_size + count;
+    }
+    if (lo < buckets_count) {
+        string_t next_head = string_t_fc_bucket_head(arr, lo, NULL);
+        *found = string_eq(&next_head, str);
+    }
+    return bucket * arr->bucket_size + count;
+}
+
+STRING_T_DEF size_t string_fc_array_rank(const string_fc_array_t *arr, const string_t *str) {
+    bool_t found;
+    return string_t_fc_rank(arr, str, &found);
+}
+
+STRING_T_DEF int string_fc_array_find(const string_fc_array_t *arr, const string_t *str) {
+    bool_t found;
+    size_t rank = string_t_fc_rank(arr, str, &found);
+    return found ? (int) rank : -1;
+}
+
+STRING_T_DEF void string_fc_iter_init(string_fc_iter_t *iter, const string_fc_array_t *arr, char *buffer) {
+    iter->arr = arr;
+    iter->idx = 0;
+    iter->pos = 0;
+    iter->str.bytes = buffer;
+    iter->str.size = 0;
+}
+
+STRING_T_DEF bool_t string_fc_iter_next(string_fc_iter_t *iter) {
+    const string_fc_array_t *arr = iter->arr;
+    if (iter->idx >= arr->size) {
+        return false;
+    }
+    if (iter->idx % arr->bucket_size == 0) {
+        string_t head = string_t_fc_bucket_head(arr, iter->idx / arr->bucket_size, &iter->pos);
+        memcpy(iter->str.bytes, head.bytes, head.size);
+        iter->str.size = head.size;
+    } else {
+        iter->pos = string_t_fc_decode_next(arr, iter->pos, iter->str.bytes, &iter->str.size);
+    }
+    iter->str.bytes[iter->str.size] = '\0';
+    ++iter->idx;
+    return true;
+}
+
+STRING_T_DEF void string_fc_array_free(string_fc_array_t *arr) {
+    free(arr->bytes);
+    free(arr->bucket_offsets);
+    free(arr);
+}
 #endif //STRING_T_H
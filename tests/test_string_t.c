@@ -23,6 +23,9 @@
  */
 #include <stdio.h>
 #include <assert.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 
 #include "../string_t.h"
@@ -110,7 +113,7 @@ test_runner_t new_runner() {
 void register_test(test_runner_t *test_runner, test_func_t test, char *description) {
     test_t *new_test = malloc(sizeof(test_t));
     new_test->test = test;
-    new_test->description = malloc(strlen(description));
+    new_test->description = malloc(strlen(description) + 1);
     strcpy(new_test->description, description);
     if (test_runner->first_test == NULL) {
         test_runner->first_test = new_node(new_test);
@@ -145,6 +148,8 @@ void runner_free(test_runner_t *test_runner) {
 /*
  * string_t tests
  */
+static const string_t STATIC_STR = STRING_T_INIT("static string");
+
 void string_arr_free(STRING_T_ARRAY str_arr, size_t size) {
     for (size_t idx = 0; idx < size; ++idx) {
         string_free(str_arr[idx]);
@@ -160,6 +165,24 @@ void test_new_string(void) {
     }
 }
 
+void test_new_string_reuse(void) {
+    string_t *strings[64];
+    for (size_t round = 0; round < 3; ++round) {
+        for (size_t idx = 0; idx < 64; ++idx) {
+            size_t size = idx * idx % 600;
+            strings[idx] = new_string(size);
+            for (size_t pos = 0; pos <= size; ++pos) {
+                assert(strings[idx]->bytes[pos] == '\0');
+            }
+            memset(strings[idx]->bytes, 'x', size);
+        }
+        for (size_t idx = 0; idx < 64; ++idx) {
+            assert(strings[idx]->size == idx * idx % 600);
+            string_free(strings[idx]);
+        }
+    }
+}
+
 void test_new_string_from_bytes(void) {
     char *bytes[] = {"", "test", "some another test"};
     for (size_t idx = 0; idx < 3; ++idx) {
@@ -208,6 +231,43 @@ void test_string_eq(void) {
     }
 }
 
+void test_string_compare(void) {
+    char *left_bytes[] = {"", "", "a", "abc", "abc", "abd", "ab"};
+    char *right_bytes[] = {"", "a", "", "abc", "abd", "abc", "abc"};
+    int expected_sign[] = {0, -1, 1, 0, -1, 1, -1};
+
+    for (size_t idx = 0; idx < 7; ++idx) {
+        string_t *left_str = new_string_from_bytes(left_bytes[idx]);
+        string_t *right_str = new_string_from_bytes(right_bytes[idx]);
+        int res = string_compare(left_str, right_str);
+        assert((res > 0) - (res < 0) == expected_sign[idx]);
+        string_free(left_str);
+        string_free(right_str);
+    }
+}
+
+void test_string_literal(void) {
+    assert(STATIC_STR.size == 13);
+    assert(string_eq(&STATIC_STR, STRING_T_LITERAL("static string")) == true);
+    assert(string_eq(&STATIC_STR, STRING_T_LITERAL("static")) == false);
+    assert(string_len(STRING_T_LITERAL("")) == 0);
+    assert(string_startswith(&STATIC_STR, "static") == true);
+    assert(string_endswith(&STATIC_STR, "string") == true);
+    assert(string_find(&STATIC_STR, "str") == 7);
+    assert(string_count(STRING_T_LITERAL("a,b,c"), ",") == 2);
+
+    const string_t *literal = STRING_T_LITERAL("  some ");
+    string_t *stripped_str = string_strip(literal);
+    string_t *concat_str = string_concat(literal, &STATIC_STR);
+    string_t *copied_str = string_copy(literal);
+    assert(string_eq(stripped_str, STRING_T_LITERAL("some")) == true);
+    assert(string_eq(concat_str, STRING_T_LITERAL("  some static string")) == true);
+    assert(string_eq(copied_str, literal) == true);
+    string_free(stripped_str);
+    string_free(concat_str);
+    string_free(copied_str);
+}
+
 void test_string_copy(void) {
     char *bytes[] = {"", "test", "some another test"};
     for (size_t idx = 0; idx < 3; ++idx) {
@@ -312,6 +372,52 @@ void test_string_find(void) {
     }
 }
 
+void test_string_count(void) {
+    char *bytes[] = {"", "a\nb\n\nc", "aaaa", "test string", "abc"};
+    char *chars[] = {"", "\n", "aa", "no", ""};
+    size_t expected_count[] = {1, 3, 2, 0, 4};
+
+    for (size_t idx = 0; idx < 5; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        assert(string_count(str, chars[idx]) == expected_count[idx]);
+        string_free(str);
+    }
+
+    string_t *long_str = new_string(200);
+    for (size_t idx = 0; idx < 200; ++idx) {
+        long_str->bytes[idx] = idx % 7 == 0 ? ',' : 'x';
+    }
+    assert(string_count(long_str, ",") == 29);
+    assert(string_count(long_str, "x,") == 28);
+    string_free(long_str);
+}
+
+void test_string_find_all(void) {
+    string_t *str = new_string_from_bytes("one,two,,three,");
+    size_t offsets[3];
+    size_t expected_offsets[] = {3, 7, 8};
+
+    assert(string_find_all(str, ",", offsets, 3) == 4);
+    for (size_t idx = 0; idx < 3; ++idx) {
+        assert(offsets[idx] == expected_offsets[idx]);
+    }
+    assert(string_find_all(str, "no", offsets, 3) == 0);
+    assert(string_find_all(str, "three,", offsets, 3) == 1);
+    assert(offsets[0] == 9);
+    string_free(str);
+
+    string_t *long_str = new_string(130);
+    memset(long_str->bytes, 'a', 130);
+    long_str->bytes[63] = 'b';
+    long_str->bytes[64] = 'c';
+    long_str->bytes[129] = 'b';
+    assert(string_find_all(long_str, "bc", offsets, 3) == 1);
+    assert(offsets[0] == 63);
+    assert(string_find_all(long_str, "b", offsets, 3) == 2);
+    assert(offsets[1] == 129);
+    string_free(long_str);
+}
+
 #ifndef _WIN32
 
 void test_string_split(void) {
@@ -506,26 +612,638 @@ void test_string_join_arr(void) {
     string_arr_free(expected_res_str, 5);
 }
 
+void test_string_array_strip(void) {
+    char *bytes[] = {"", "vfv\n\n", "  test\t", " some another test  ", " \t ", "a"};
+    char *stripped_bytes[] = {"", "vfv", "test", "some another test", "", "a"};
+
+    STRING_T_ARRAY str_arr = calloc(6, sizeof(string_t *));
+    for (size_t idx = 0; idx < 6; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+    string_array_strip(str_arr, 6);
+    for (size_t idx = 0; idx < 6; ++idx) {
+        assert(str_arr[idx]->size == strlen(stripped_bytes[idx]));
+        assert(memcmp(str_arr[idx]->bytes, stripped_bytes[idx], str_arr[idx]->size) == 0);
+    }
+    string_array_free(str_arr, 6);
+}
+
+void test_string_array_filter_empty(void) {
+    char *bytes[] = {"", "some", "", "", "string", ""};
+
+    STRING_T_ARRAY str_arr = calloc(6, sizeof(string_t *));
+    for (size_t idx = 0; idx < 6; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+    size_t arr_size = string_array_filter_empty(str_arr, 6);
+    assert(arr_size == 2);
+    assert(strcmp(str_arr[0]->bytes, "some") == 0);
+    assert(strcmp(str_arr[1]->bytes, "string") == 0);
+    string_array_free(str_arr, arr_size);
+}
+
+void test_string_array_map_lower(void) {
+    char *bytes[] = {"", "ABC", "Some Another TEST [@`{]", "\xC0\xDA UPPER"};
+    char *lower_bytes[] = {"", "abc", "some another test [@`{]", "\xC0\xDA upper"};
+
+    STRING_T_ARRAY str_arr = calloc(4, sizeof(string_t *));
+    for (size_t idx = 0; idx < 4; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+    string_array_map_lower(str_arr, 4);
+    for (size_t idx = 0; idx < 4; ++idx) {
+        assert(memcmp(str_arr[idx]->bytes, lower_bytes[idx], str_arr[idx]->size) == 0);
+    }
+    string_array_free(str_arr, 4);
+}
+
+void test_string_parse_i64(void) {
+    char *bytes[] = {"0", "-0", "+42", "-123456789012", "9223372036854775807", "-9223372036854775808",
+                     "00000000000000000000000017"};
+    int64_t expected_values[] = {0, 0, 42, -123456789012LL, INT64_MAX, INT64_MIN, 17};
+    for (size_t idx = 0; idx < 7; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        int64_t value = -1;
+        assert(string_parse_i64(str, &value) == STRING_T_PARSE_OK);
+        assert(value == expected_values[idx]);
+        string_free(str);
+    }
+
+    char *invalid_bytes[] = {"", "-", "12a", " 1", "1.0", "123456789x12345"};
+    for (size_t idx = 0; idx < 6; ++idx) {
+        string_t *str = new_string_from_bytes(invalid_bytes[idx]);
+        int64_t value = 0;
+        assert(string_parse_i64(str, &value) == STRING_T_PARSE_INVALID);
+        string_free(str);
+    }
+
+    char *overflow_bytes[] = {"9223372036854775808", "-9223372036854775809", "100000000000000000000"};
+    for (size_t idx = 0; idx < 3; ++idx) {
+        string_t *str = new_string_from_bytes(overflow_bytes[idx]);
+        int64_t value = 0;
+        assert(string_parse_i64(str, &value) == STRING_T_PARSE_OVERFLOW);
+        string_free(str);
+    }
+}
+
+void test_string_parse_u64(void) {
+    char *bytes[] = {"0", "12345678", "123456789", "18446744073709551615"};
+    uint64_t expected_values[] = {0, 12345678, 123456789, UINT64_MAX};
+    for (size_t idx = 0; idx < 4; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        uint64_t value = 1;
+        assert(string_parse_u64(str, &value) == STRING_T_PARSE_OK);
+        assert(value == expected_values[idx]);
+        string_free(str);
+    }
+
+    string_t *str = new_string_from_bytes("18446744073709551616");
+    uint64_t value = 0;
+    assert(string_parse_u64(str, &value) == STRING_T_PARSE_OVERFLOW);
+    string_free(str);
+
+    str = new_string_from_bytes("-1");
+    assert(string_parse_u64(str, &value) == STRING_T_PARSE_INVALID);
+    string_free(str);
+}
+
+void test_string_parse_f64(void) {
+    char *bytes[] = {"0", "-0.5", "3.25", "1e10", ".5", "5.", "123456789.125e-3", "0.1", "1.7976931348623157e308",
+                     "12345678901234567890123", "4.9e-324", "1.5e-30", "0e-100", "0.00000000000000000000000000",
+                     "-0e-99999"};
+    for (size_t idx = 0; idx < 15; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        double value = -1;
+        assert(string_parse_f64(str, &value) == STRING_T_PARSE_OK);
+        assert(value == strtod(bytes[idx], NULL));
+        string_free(str);
+    }
+
+    char *invalid_bytes[] = {"", ".", "-", "1e", "1.2.3", "inf", " 1", "0x10"};
+    for (size_t idx = 0; idx < 8; ++idx) {
+        string_t *str = new_string_from_bytes(invalid_bytes[idx]);
+        double value = 0;
+        assert(string_parse_f64(str, &value) == STRING_T_PARSE_INVALID);
+        string_free(str);
+    }
+
+    string_t *str = new_string_from_bytes("-1e400");
+    double value = 0;
+    assert(string_parse_f64(str, &value) == STRING_T_PARSE_OVERFLOW);
+    string_free(str);
+}
+
+void test_string_parse_arr(void) {
+    string_t *str_arr[] = {
+            new_string_from_bytes("1"),
+            new_string_from_bytes("-2"),
+            new_string_from_bytes("3.5"),
+    };
+    int64_t i64_values[3];
+    uint64_t u64_values[3];
+    double f64_values[3];
+
+    assert(string_parse_i64_arr(str_arr, 3, i64_values) == 2);
+    assert(i64_values[0] == 1 && i64_values[1] == -2);
+    assert(string_parse_u64_arr(str_arr, 3, u64_values) == 1);
+    assert(u64_values[0] == 1);
+    assert(string_parse_f64_arr(str_arr, 3, f64_values) == 3);
+    assert(f64_values[0] == 1.0 && f64_values[1] == -2.0 && f64_values[2] == 3.5);
+
+    string_arr_free(str_arr, 3);
+}
+
+void test_string_csv_next(void) {
+    string_t *str = new_string_from_bytes(
+            "id,name,comment\r\n"
+            "1,\"Doe, John\",\"said \"\"hi\"\"\"\n"
+            "2,,\"multi\nline, long enough to cross the 64 bytes block boundary\"\n"
+            "3,last,");
+    char *expected_fields[] = {
+            "id", "name", "comment",
+            "1", "Doe, John", "said \"\"hi\"\"",
+            "2", "", "multi\nline, long enough to cross the 64 bytes block boundary",
+            "3", "last", ""
+    };
+    bool_t expected_quoted[] = {false, false, false, false, true, true, false, false, true, false, false, false};
+
+    string_csv_t reader;
+    string_csv_init(&reader, str, ',', true);
+    string_csv_field_t fields[3];
+    size_t fields_count = 0;
+    for (size_t record = 0; record < 4; ++record) {
+        assert(string_csv_next(&reader, fields, 3, &fields_count) == true);
+        assert(fields_count == 3);
+        for (size_t idx = 0; idx < 3; ++idx) {
+            char *expected = expected_fields[record * 3 + idx];
+            assert(fields[idx].value.size == strlen(expected));
+            assert(memcmp(fields[idx].value.bytes, expected, strlen(expected)) == 0);
+            assert(fields[idx].quoted == expected_quoted[record * 3 + idx]);
+        }
+    }
+    assert(string_csv_next(&reader, fields, 3, &fields_count) == false);
+    string_free(str);
+
+    str = new_string_from_bytes("a\tb\tc\td\n\"e\tf");
+    string_csv_init(&reader, str, '\t', false);
+    assert(string_csv_next(&reader, fields, 3, &fields_count) == true);
+    assert(fields_count == 4);
+    assert(fields[2].value.size == 1 && fields[2].value.bytes[0] == 'c');
+    assert(string_csv_next(&reader, fields, 3, &fields_count) == false);
+    assert(reader.pos == 8);
+    string_free(str);
+}
+
+void test_string_csv_unescape(void) {
+    string_t *str = new_string_from_bytes("\"say \"\"hi\"\"\",plain");
+    string_csv_t reader;
+    string_csv_init(&reader, str, ',', true);
+    string_csv_field_t fields[2];
+    size_t fields_count = 0;
+    assert(string_csv_next(&reader, fields, 2, &fields_count) == true);
+    assert(fields_count == 2);
+
+    string_t *unescaped = string_csv_unescape(&fields[0]);
+    assert(strcmp(unescaped->bytes, "say \"hi\"") == 0);
+    assert(unescaped->size == 8);
+    string_free(unescaped);
+
+    unescaped = string_csv_unescape(&fields[1]);
+    assert(strcmp(unescaped->bytes, "plain") == 0);
+    string_free(unescaped);
+    string_free(str);
+}
+
+void test_string_glob_match(void) {
+    char *patterns[] = {"*", "*.log", "user.*.name", "a?c", "[a-c]x", "[!a-c]x", "\\*x", "a*b*c", "[]]", "*a"};
+    char *bytes[] = {"", "app.log", "user.42.name", "abc", "bx", "dx", "*x", "axxbyyc", "]", "bbbba"};
+    char *non_matching_bytes[] = {NULL, "app.log.1", "user.name", "ac", "dx", "bx", "ax", "axxcyyb", "a", "ab"};
+
+    for (size_t idx = 0; idx < 10; ++idx) {
+        string_glob_t *glob = string_glob_compile(patterns[idx]);
+        assert(glob != NULL);
+
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        assert(string_glob_match(glob, str) == true);
+        string_free(str);
+
+        if (non_matching_bytes[idx] != NULL) {
+            str = new_string_from_bytes(non_matching_bytes[idx]);
+            assert(string_glob_match(glob, str) == false);
+            string_free(str);
+        }
+        string_glob_free(glob);
+    }
+
+    assert(string_glob_compile("[abc") == NULL);
+
+    char long_pattern[202];
+    char long_bytes[201];
+    for (size_t idx = 0; idx < 200; ++idx) {
+        long_pattern[idx] = idx == 100 ? '*' : idx % 2 ? '?' : 'z';
+        long_bytes[idx] = 'z';
+    }
+    long_pattern[200] = 'y';
+    long_pattern[201] = '\0';
+    long_bytes[199] = 'y';
+    long_bytes[200] = '\0';
+    string_glob_t *glob = string_glob_compile(long_pattern);
+    string_t *str = new_string_from_bytes(long_bytes);
+    assert(string_glob_match(glob, str) == true);
+    str->bytes[198] = 'y';
+    str->bytes[199] = 'z';
+    assert(string_glob_match(glob, str) == false);
+    string_free(str);
+    string_glob_free(glob);
+}
+
+void test_string_levenshtein(void) {
+    char *first_bytes[] = {"", "abc", "kitten", "flaw", "intention", "same"};
+    char *second_bytes[] = {"", "", "sitting", "lawn", "execution", "same"};
+    size_t expected_distance[] = {0, 3, 3, 2, 5, 0};
+
+    for (size_t idx = 0; idx < 6; ++idx) {
+        string_t *first = new_string_from_bytes(first_bytes[idx]);
+        string_t *second = new_string_from_bytes(second_bytes[idx]);
+        assert(string_levenshtein(first, second) == expected_distance[idx]);
+        assert(string_levenshtein(second, first) == expected_distance[idx]);
+        string_free(first);
+        string_free(second);
+    }
+
+    string_t *first = new_string(150);
+    string_t *second = new_string(150);
+    memset(first->bytes, 'a', 150);
+    memset(second->bytes, 'a', 150);
+    second->bytes[0] = 'b';
+    second->bytes[70] = 'b';
+    second->bytes[149] = 'b';
+    assert(string_levenshtein(first, second) == 3);
+    second->size = 100;
+    assert(string_levenshtein(first, second) == 52);
+    string_free(first);
+    string_free(second);
+}
+
+void test_string_levenshtein_within(void) {
+    string_t *first = new_string_from_bytes("kitten");
+    string_t *second = new_string_from_bytes("sitting");
+    string_t *third = new_string_from_bytes("kit");
+
+    assert(string_levenshtein_within(first, second, 3) == true);
+    assert(string_levenshtein_within(first, second, 2) == false);
+    assert(string_levenshtein_within(first, third, 2) == false);
+    assert(string_levenshtein_within(first, third, 3) == true);
+
+    string_free(first);
+    string_free(second);
+    string_free(third);
+}
+
+void test_string_fuzzy_find(void) {
+    char *bytes[] = {"", "connection refused by host", "connection refused by host", "abc", "some text"};
+    char *chars[] = {"x", "refuzed", "resolved", "", "txet"};
+    size_t max_distance[] = {1, 1, 2, 0, 2};
+    int expected_pos[] = {0, 11, -1, 0, 5};
+
+    for (size_t idx = 0; idx < 5; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        assert(string_fuzzy_find(str, chars[idx], max_distance[idx]) == expected_pos[idx]);
+        string_free(str);
+    }
+}
+
+void test_string_base64(void) {
+    char *bytes[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar",
+                     "The quick brown fox jumps over the lazy dog and keeps running"};
+    char *encoded_bytes[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy",
+                             "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZyBhbmQga2VlcHMgcnVubmluZw=="};
+
+    for (size_t idx = 0; idx < 8; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        string_t *encoded_str = string_base64_encode(str);
+        assert(strcmp(encoded_str->bytes, encoded_bytes[idx]) == 0);
+        assert(string_base64_decoded_len(encoded_str) == str->size);
+
+        string_t *decoded_str = string_base64_decode(encoded_str);
+        assert(decoded_str != NULL);
+        assert(string_eq(decoded_str, str) == true);
+
+        string_free(str);
+        string_free(encoded_str);
+        string_free(decoded_str);
+    }
+
+    char *invalid_bytes[] = {"Zg=", "Zg=a", "Z===", "Zh==", "Zm9v!mFy", "Zm=vYmFy",
+                             "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcy-vdmVyIHRoZSBsYXp5IGRvZw=="};
+    for (size_t idx = 0; idx < 7; ++idx) {
+        string_t *str = new_string_from_bytes(invalid_bytes[idx]);
+        assert(string_base64_decode(str) == NULL);
+        string_free(str);
+    }
+}
+
+void test_string_hex(void) {
+    string_t *str = new_string(40);
+    for (size_t idx = 0; idx < 40; ++idx) {
+        str->bytes[idx] = (char) (idx * 37);
+    }
+    string_t *encoded_str = string_hex_encode(str);
+    assert(encoded_str->size == 80);
+    assert(strncmp(encoded_str->bytes, "00254a6f94b9de03284d", 20) == 0);
+
+    string_t *decoded_str = string_hex_decode(encoded_str);
+    assert(decoded_str != NULL);
+    assert(decoded_str->size == 40 && memcmp(decoded_str->bytes, str->bytes, 40) == 0);
+    string_free(decoded_str);
+
+    encoded_str->bytes[5] = 'A';
+    encoded_str->bytes[70] = 'F';
+    decoded_str = string_hex_decode(encoded_str);
+    assert(decoded_str != NULL);
+    assert((unsigned char) decoded_str->bytes[2] == 0x4A && (unsigned char) decoded_str->bytes[35] == 0xFF);
+    string_free(decoded_str);
+
+    encoded_str->bytes[10] = 'g';
+    assert(string_hex_decode(encoded_str) == NULL);
+    encoded_str->bytes[10] = '0';
+    encoded_str->bytes[79] = 'x';
+    assert(string_hex_decode(encoded_str) == NULL);
+    encoded_str->size = 79;
+    assert(string_hex_decode(encoded_str) == NULL);
+
+    string_free(str);
+    string_free(encoded_str);
+}
+
+void test_string_prefix_set(void) {
+    const char *prefixes[] = {"/api/v1/", "/api/", "/static/", "/api/v1/users/", "/api/v2/", "/api/"};
+    string_prefix_set_t *set = new_string_prefix_set(prefixes, 6);
+
+    char *bytes[] = {"/api/v1/users/42", "/api/v1/orders", "/api/v3", "/static/app.js", "/health", "/ap", ""};
+    int expected_len[] = {14, 8, 5, 8, -1, -1, -1};
+    for (size_t idx = 0; idx < 7; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        assert(string_prefix_set_longest_match(set, str) == expected_len[idx]);
+        assert(string_prefix_set_any_match(set, str) == (expected_len[idx] >= 0));
+        string_free(str);
+    }
+    string_prefix_set_free(set);
+
+    const char *empty_prefix[] = {""};
+    set = new_string_prefix_set(empty_prefix, 1);
+    string_t *str = new_string_from_bytes("any");
+    assert(string_prefix_set_longest_match(set, str) == 0);
+    string_free(str);
+    string_prefix_set_free(set);
+
+    set = new_string_prefix_set(NULL, 0);
+    str = new_string_from_bytes("any");
+    assert(string_prefix_set_any_match(set, str) == false);
+    string_free(str);
+    string_prefix_set_free(set);
+}
+
+void test_string_suffix_set(void) {
+    const char *suffixes[] = {".log", ".tar.gz", ".gz", "error.log"};
+    string_prefix_set_t *set = new_string_suffix_set(suffixes, 4);
+
+    char *bytes[] = {"app.log", "app.error.log", "backup.tar.gz", "data.gz", "data.txt", "gz"};
+    int expected_len[] = {4, 9, 7, 3, -1, -1};
+    for (size_t idx = 0; idx < 6; ++idx) {
+        string_t *str = new_string_from_bytes(bytes[idx]);
+        assert(string_prefix_set_longest_match(set, str) == expected_len[idx]);
+        assert(string_prefix_set_any_match(set, str) == (expected_len[idx] >= 0));
+        string_free(str);
+    }
+    string_prefix_set_free(set);
+}
+
+void test_string_array_sort(void) {
+    char *bytes[] = {"pear", "apple", "", "apple pie with cream", "apple pie with crumble", "b", "apple",
+                     "apple pie", "zebra", "apple pie with cream and more", "a", "", "banana", "apple pie",
+                     "cherry", "apricot", "date", "fig", "grape"};
+    char *sorted_bytes[] = {"", "", "a", "apple", "apple", "apple pie", "apple pie", "apple pie with cream",
+                            "apple pie with cream and more", "apple pie with crumble", "apricot", "b", "banana",
+                            "cherry", "date", "fig", "grape", "pear", "zebra"};
+
+    STRING_T_ARRAY str_arr = calloc(19, sizeof(string_t *));
+    for (size_t idx = 0; idx < 19; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+    string_array_sort(str_arr, 19);
+    for (size_t idx = 0; idx < 19; ++idx) {
+        assert(strcmp(str_arr[idx]->bytes, sorted_bytes[idx]) == 0);
+    }
+    string_array_free(str_arr, 19);
+}
+
+void test_string_array_sort_organ_pipe(void) {
+    size_t arr_size = 4096;
+    STRING_T_ARRAY str_arr = calloc(arr_size, sizeof(string_t *));
+    char bytes[32];
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        size_t key = idx < arr_size / 2 ? idx * 2 : (arr_size - idx) * 2 - 1;
+        sprintf(bytes, "key%012lu", (unsigned long) key);
+        str_arr[idx] = new_string_from_bytes(bytes);
+    }
+    string_array_sort(str_arr, arr_size);
+    for (size_t idx = 0; idx < arr_size; ++idx) {
+        sprintf(bytes, "key%012lu", (unsigned long) idx);
+        assert(strcmp(str_arr[idx]->bytes, bytes) == 0);
+    }
+    string_array_free(str_arr, arr_size);
+}
+
+void test_string_array_sort_unique(void) {
+    char *bytes[] = {"b", "a", "b", "", "c", "a", ""};
+    char *unique_bytes[] = {"", "a", "b", "c"};
+
+    STRING_T_ARRAY str_arr = calloc(7, sizeof(string_t *));
+    for (size_t idx = 0; idx < 7; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+    size_t arr_size = string_array_sort_unique(str_arr, 7);
+    assert(arr_size == 4);
+    for (size_t idx = 0; idx < 4; ++idx) {
+        assert(strcmp(str_arr[idx]->bytes, unique_bytes[idx]) == 0);
+    }
+    string_array_free(str_arr, arr_size);
+}
+
+void test_string_fc_array(void) {
+    char *bytes[] = {"", "a", "apple", "apple", "apple pie", "apple pie with cream", "apple pie with crumble",
+                     "apricot", "b", "banana", "cherry"};
+    STRING_T_ARRAY str_arr = calloc(11, sizeof(string_t *));
+    for (size_t idx = 0; idx < 11; ++idx) {
+        str_arr[idx] = new_string_from_bytes(bytes[idx]);
+    }
+
+    string_fc_array_t *arr = new_string_fc_array(str_arr, 11, 4);
+    assert(string_fc_array_len(arr) == 11);
+    char buffer[32];
+    for (size_t idx = 0; idx < 11; ++idx) {
+        assert(string_fc_array_get(arr, idx, buffer) == strlen(bytes[idx]));
+        assert(strcmp(buffer, bytes[idx]) == 0);
+
+        string_t *str = string_fc_array_at(arr, idx);
+        assert(string_eq(str, str_arr[idx]));
+        string_free(str);
+    }
+
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("")) == 0);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("apple")) == 2);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("apple pie")) == 4);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("apricot")) == 7);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("b")) == 8);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("cherry")) == 10);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("apple pie with")) == -1);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("apples")) == -1);
+    assert(string_fc_array_find(arr, STRING_T_LITERAL("zebra")) == -1);
+
+    assert(string_fc_array_rank(arr, STRING_T_LITERAL("")) == 0);
+    assert(string_fc_array_rank(arr, STRING_T_LITERAL("apple ")) == 4);
+    assert(string_fc_array_rank(arr, STRING_T_LITERAL("apple pie with d")) == 7);
+    assert(string_fc_array_rank(arr, STRING_T_LITERAL("az")) == 8);
+    assert(string_fc_array_rank(arr, STRING_T_LITERAL("zebra")) == 11);
+
+    string_fc_iter_t iter;
+    string_fc_iter_init(&iter, arr, buffer);
+    size_t count = 0;
+    while (string_fc_iter_next(&iter)) {
+        assert(string_eq(&iter.str, str_arr[count]));
+        ++count;
+    }
+    assert(count == 11);
+    string_fc_array_free(arr);
+
+    string_t *unsorted[] = {str_arr[1], str_arr[0]};
+    assert(new_string_fc_array(unsorted, 2, 0) == NULL);
+    string_array_free(str_arr, 11);
+}
+
+#ifndef _WIN32
+#define THREADS_STRINGS_COUNT 1000
+#define THREADS_COUNT 4
+
+void *thread_new_strings(void *arg) {
+    (void) arg;
+    STRING_T_ARRAY str_arr = calloc(THREADS_STRINGS_COUNT, sizeof(string_t *));
+    for (size_t idx = 0; idx < THREADS_STRINGS_COUNT; ++idx) {
+        str_arr[idx] = new_string(idx % 300);
+        memset(str_arr[idx]->bytes, 'a' + idx % 26, idx % 300);
+    }
+    return str_arr;
+}
+
+void *thread_free_strings(void *arg) {
+    STRING_T_ARRAY str_arr = arg;
+    for (size_t idx = 0; idx < THREADS_STRINGS_COUNT / THREADS_COUNT; ++idx) {
+        string_t *str = new_string_from_bytes("thread string");
+        string_free(str_arr[idx]);
+        assert(strcmp(str->bytes, "thread string") == 0);
+        string_free(str);
+    }
+    return NULL;
+}
+
+void *thread_pool(void *arg) {
+    (void) arg;
+    string_t *str = new_string_from_bytes("thread string");
+    string_free(str);
+#ifdef STRING_T_POOL
+    return string_t_local_pool;
+#else
+    return NULL;
+#endif
+}
+
+void test_string_threads_free(void) {
+    pthread_t threads[THREADS_COUNT];
+    void *result;
+    pthread_create(threads, NULL, &thread_new_strings, NULL);
+    pthread_join(threads[0], &result);
+    STRING_T_ARRAY str_arr = result;
+    for (size_t idx = 0; idx < THREADS_STRINGS_COUNT; ++idx) {
+        assert(str_arr[idx]->size == idx % 300);
+        assert(idx % 300 == 0 || str_arr[idx]->bytes[idx % 300 - 1] == (char) ('a' + idx % 26));
+    }
+
+    // Strings of exited thread are freed concurrently by other threads
+    for (size_t idx = 0; idx < THREADS_COUNT; ++idx) {
+        pthread_create(threads + idx, NULL, &thread_free_strings,
+                       str_arr + idx * (THREADS_STRINGS_COUNT / THREADS_COUNT));
+    }
+    for (size_t idx = 0; idx < THREADS_COUNT; ++idx) {
+        pthread_join(threads[idx], NULL);
+    }
+    free(str_arr);
+}
+
+void test_string_threads_exit(void) {
+    void *first_pool = NULL;
+    for (size_t idx = 0; idx < 50; ++idx) {
+        pthread_t thread;
+        void *pool;
+        pthread_create(&thread, NULL, &thread_pool, NULL);
+        pthread_join(thread, &pool);
+        // Pool of exited thread is adopted by the next one
+        first_pool = idx == 0 ? pool : first_pool;
+        assert(pool == first_pool);
+    }
+}
+#endif
+
 int main() {
     test_runner_t runner = new_runner();
 
     register_test(&runner, &test_new_string, "Test new_string");
+    register_test(&runner, &test_new_string_reuse, "Test new_string reuse");
     register_test(&runner, &test_new_string_from_bytes, "Test new_string_from_bytes");
     register_test(&runner, &test_string_len, "Test string_len");
     register_test(&runner, &test_string_bytes, "Test string_bytes");
     register_test(&runner, &test_string_eq, "Test string_eq");
+    register_test(&runner, &test_string_compare, "Test string_compare");
+    register_test(&runner, &test_string_literal, "Test STRING_T_LITERAL");
     register_test(&runner, &test_string_copy, "Test string_copy");
     register_test(&runner, &test_string_concat, "Test string_concat");
     register_test(&runner, &test_string_substr, "Test string_substr");
     register_test(&runner, &test_string_startswith, "Test string_startswith");
     register_test(&runner, &test_string_endswith, "Test string_endswith");
     register_test(&runner, &test_string_find, "Test string_find");
+    register_test(&runner, &test_string_count, "Test string_count");
+    register_test(&runner, &test_string_find_all, "Test string_find_all");
     register_test(&runner, &test_string_strip, "Test string_strip");
 #ifndef _WIN32
     register_test(&runner, &test_string_split, "Test string_split");
     register_test(&runner, &test_string_split_by, "Test string_split_by");
 #endif
     register_test(&runner, &test_string_join_arr, "Test test_string_join_arr");
+    register_test(&runner, &test_string_array_strip, "Test string_array_strip");
+    register_test(&runner, &test_string_array_filter_empty, "Test string_array_filter_empty");
+    register_test(&runner, &test_string_array_map_lower, "Test string_array_map_lower");
+    register_test(&runner, &test_string_parse_i64, "Test string_parse_i64");
+    register_test(&runner, &test_string_parse_u64, "Test string_parse_u64");
+    register_test(&runner, &test_string_parse_f64, "Test string_parse_f64");
+    register_test(&runner, &test_string_parse_arr, "Test string_parse_*_arr");
+    register_test(&runner, &test_string_csv_next, "Test string_csv_next");
+    register_test(&runner, &test_string_csv_unescape, "Test string_csv_unescape");
+    register_test(&runner, &test_string_glob_match, "Test string_glob_match");
+    register_test(&runner, &test_string_levenshtein, "Test string_levenshtein");
+    register_test(&runner, &test_string_levenshtein_within, "Test string_levenshtein_within");
+    register_test(&runner, &test_string_fuzzy_find, "Test string_fuzzy_find");
+    register_test(&runner, &test_string_base64, "Test string_base64_*");
+    register_test(&runner, &test_string_hex, "Test string_hex_*");
+    register_test(&runner, &test_string_prefix_set, "Test string_prefix_set");
+    register_test(&runner, &test_string_suffix_set, "Test string_suffix_set");
+    register_test(&runner, &test_string_array_sort, "Test string_array_sort");
+    register_test(&runner, &test_string_array_sort_organ_pipe, "Test string_array_sort organ pipe");
+    register_test(&runner, &test_string_array_sort_unique, "Test string_array_sort_unique");
+    register_test(&runner, &test_string_fc_array, "Test string_fc_array");
+#ifndef _WIN32
+    register_test(&runner, &test_string_threads_free, "Test strings freed by other threads");
+    register_test(&runner, &test_string_threads_exit, "Test strings pool of exited thread");
+#endif
 
     run_tests(&runner);
     runner_free(&runner);